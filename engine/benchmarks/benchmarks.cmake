@@ -0,0 +1,3 @@
+include(third_party/benchmark)
+
+add_subdirectory(benchmarks)
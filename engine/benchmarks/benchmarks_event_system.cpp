@@ -0,0 +1,112 @@
+#include <vector>
+
+#include <engine/events/event_system.hpp>
+#include <engine/events/window_events.hpp>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+
+struct BenchmarkEvent
+{
+    int value = 0;
+};
+
+void HandlerCounts(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->RangeMultiplier(8)->Range(1, 4096);
+}
+
+} // namespace
+
+// Subscribe and unsubscribe a batch of handlers
+void BM_EventSystemSubscribe(benchmark::State& state)
+{
+    game_engine::EventSystem event_system;
+
+    const auto handlers = static_cast<std::size_t>(state.range(0));
+
+    std::vector<game_engine::EventSystem::Subscription> subscriptions;
+    subscriptions.reserve(handlers);
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < handlers; ++i) {
+            subscriptions.push_back(event_system.Subscribe<BenchmarkEvent>([](const BenchmarkEvent&) {}));
+        }
+        subscriptions.clear();
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * handlers));
+}
+BENCHMARK(BM_EventSystemSubscribe)->Apply(HandlerCounts);
+
+// Immediate dispatch of one event to all handlers
+void BM_EventSystemProcessEvent(benchmark::State& state)
+{
+    game_engine::EventSystem event_system;
+
+    int sum = 0;
+    std::vector<game_engine::EventSystem::Subscription> subscriptions;
+    for (std::int64_t i = 0; i < state.range(0); ++i) {
+        subscriptions.push_back(event_system.Subscribe<BenchmarkEvent>([&sum](const BenchmarkEvent& event) { sum += event.value; }));
+    }
+
+    for (auto _ : state) {
+        event_system.ProcessEvent(BenchmarkEvent{1});
+    }
+
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EventSystemProcessEvent)->Apply(HandlerCounts);
+
+// Deferred dispatch of a frame worth of events
+void BM_EventSystemEnqueueFlush(benchmark::State& state)
+{
+    constexpr int EventsPerFlush = 64;
+
+    game_engine::EventSystem event_system;
+
+    int sum = 0;
+    std::vector<game_engine::EventSystem::Subscription> subscriptions;
+    for (std::int64_t i = 0; i < state.range(0); ++i) {
+        subscriptions.push_back(event_system.Subscribe<BenchmarkEvent>([&sum](const BenchmarkEvent& event) { sum += event.value; }));
+    }
+
+    for (auto _ : state) {
+        for (int i = 0; i < EventsPerFlush; ++i) {
+            event_system.Enqueue(BenchmarkEvent{i});
+        }
+        event_system.Flush();
+    }
+
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * EventsPerFlush);
+}
+BENCHMARK(BM_EventSystemEnqueueFlush)->Apply(HandlerCounts);
+
+// Keyboard event with one handler bound to each key, only the matching one runs
+void BM_EventSystemKeyedDispatch(benchmark::State& state)
+{
+    using namespace game_engine;
+
+    EventSystem event_system;
+
+    int calls = 0;
+    std::vector<EventSystem::Subscription> subscriptions;
+    for (int key = static_cast<int>(KeyCode::A); key <= static_cast<int>(KeyCode::Z); ++key) {
+        subscriptions.push_back(event_system.SubscribeKey(static_cast<KeyCode>(key), KeyAction::Press, [&calls](const KeyboardInputEvent&) {
+            ++calls;
+        }));
+    }
+
+    const KeyboardInputEvent event{KeyCode::Q, KeyAction::Press, KeyModifier::None};
+    for (auto _ : state) {
+        event_system.ProcessEvent(event);
+    }
+
+    benchmark::DoNotOptimize(calls);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EventSystemKeyedDispatch);
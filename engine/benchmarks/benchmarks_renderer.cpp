@@ -0,0 +1,287 @@
+#include <array>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <frame_stats_collector.hpp>
+#include <graphics/renderer_impl.hpp>
+#include <resource_management/resources/mesh_resource.hpp>
+#include <resource_management/resources/shader_resource.hpp>
+
+#include <modules/backend/backend_module.hpp>
+#include <modules/module_locator.hpp>
+
+#include <benchmark/benchmark.h>
+#include <stub_renderer.hpp>
+
+namespace
+{
+
+/// @brief Backend without a window, only provides the context calls of the render thread.
+class NullBackend final : public game_engine::backend::IBackendModule
+{
+public:
+
+    bool Init(const game_engine::GameSettings&) noexcept override
+    {
+        return true;
+    }
+
+    void Shutdown() noexcept override
+    {}
+
+    void AttachBackendObserver(game_engine::IBackendObserver&) override
+    {}
+
+    void DetachBackendObserver(const game_engine::IBackendObserver&) override
+    {}
+
+    void PollEvents() const override
+    {}
+
+    void MakeContextCurrent() const override
+    {}
+
+    void DropCurrentContext() const override
+    {}
+
+    void SwapBuffers() const override
+    {}
+};
+
+/// @brief RendererImpl running on the stub renderer module, with a mesh and a shader to draw.
+class RendererFixture
+{
+public:
+
+    RendererFixture()
+    {
+        using namespace game_engine;
+
+        stub = std::make_shared<graphics::StubRenderer>();
+
+        ModuleLocator locator;
+        locator.SetImplementation<backend::IBackendModule>(std::make_shared<NullBackend>());
+        locator.SetImplementation<graphics::IRendererModule>(stub);
+
+        renderer = std::make_shared<RendererImpl>(locator, std::make_shared<FrameStatsCollector>());
+        renderer->SetAutomaticInstancing(true);
+        renderer->Init();
+
+        mesh   = std::make_shared<MeshResource>(1, "mesh");
+        shader = std::make_shared<ShaderResource>(2, "shader");
+
+        renderer->Load(mesh);
+        renderer->Load(shader);
+    }
+
+    ~RendererFixture()
+    {
+        renderer->Shutdown();
+    }
+
+    RendererFixture(const RendererFixture&) = delete;
+    RendererFixture(RendererFixture&&)      = delete;
+
+    RendererFixture& operator=(const RendererFixture&) = delete;
+    RendererFixture& operator=(RendererFixture&&)      = delete;
+
+    void SubmitFrame(std::int64_t commands)
+    {
+        for (std::int64_t i = 0; i < commands; ++i) {
+            renderer->Render(mesh, shader, {
+                                               {"model", game_engine::Matrix4(1.0f)},
+                                               {"color", game_engine::Vector4(1.0f)},
+            });
+        }
+        renderer->EndFrame();
+    }
+
+    /// @brief Same frame as SubmitFrame, recorded with interned property ids.
+    void SubmitFrameInterned(std::int64_t commands)
+    {
+        const std::array<game_engine::PropertyBinding, 2> properties = {
+            game_engine::PropertyBinding{model_id, game_engine::Matrix4(1.0f)},
+            game_engine::PropertyBinding{color_id, game_engine::Vector4(1.0f)},
+        };
+
+        for (std::int64_t i = 0; i < commands; ++i) {
+            renderer->Render(mesh, shader, properties, {});
+        }
+        renderer->EndFrame();
+    }
+
+    /// @brief Blocks until the render thread has executed everything submitted so far.
+    void WaitForRenderThread()
+    {
+        renderer->WaitForFrames();
+    }
+
+    std::shared_ptr<game_engine::graphics::StubRenderer> stub;
+    std::shared_ptr<game_engine::RendererImpl> renderer;
+    std::shared_ptr<game_engine::MeshResource> mesh;
+    std::shared_ptr<game_engine::ShaderResource> shader;
+
+    const game_engine::PropertyId model_id{"model"};
+    const game_engine::PropertyId color_id{"color"};
+};
+
+} // namespace
+
+// Main thread cost of recording a frame and handing it to the render thread
+void BM_RendererSubmitFrame(benchmark::State& state)
+{
+    RendererFixture fixture;
+
+    for (auto _ : state) {
+        fixture.SubmitFrame(state.range(0));
+
+        // Keep the render thread queue short without measuring it
+        state.PauseTiming();
+        fixture.WaitForRenderThread();
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RendererSubmitFrame)->RangeMultiplier(8)->Range(8, 4096)->UseRealTime();
+
+// Same as BM_RendererSubmitFrame without building and interning the property names
+void BM_RendererSubmitFrameInterned(benchmark::State& state)
+{
+    RendererFixture fixture;
+
+    for (auto _ : state) {
+        fixture.SubmitFrameInterned(state.range(0));
+
+        state.PauseTiming();
+        fixture.WaitForRenderThread();
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RendererSubmitFrameInterned)->RangeMultiplier(8)->Range(8, 4096)->UseRealTime();
+
+// Full frame: recording, hand-over and execution on the render thread
+void BM_RendererFrameRoundTrip(benchmark::State& state)
+{
+    RendererFixture fixture;
+
+    for (auto _ : state) {
+        fixture.SubmitFrame(state.range(0));
+        fixture.WaitForRenderThread();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RendererFrameRoundTrip)->RangeMultiplier(8)->Range(8, 4096)->UseRealTime();
+
+// State changes of a 10k draw scene with interleaved shaders and meshes, counted by the stub renderer.
+// Opaque draws are sorted by their keys, transparent ones keep the submission order and show the unsorted cost.
+// Sorted draws of the same mesh and shader end up next to each other and are merged into instanced draws.
+void BM_RendererStateChanges(benchmark::State& state)
+{
+    using namespace game_engine;
+
+    constexpr std::size_t Draws   = 10'000;
+    constexpr std::size_t Shaders = 16;
+    constexpr std::size_t Meshes  = 256;
+
+    const DrawOrder order{.pass = static_cast<RenderPass>(state.range(0))};
+
+    RendererFixture fixture;
+
+    std::vector<std::shared_ptr<ShaderResource>> shaders;
+    for (std::size_t i = 0; i < Shaders; ++i) {
+        shaders.push_back(std::make_shared<ShaderResource>(100 + i, "shader"));
+        fixture.renderer->Load(shaders.back());
+    }
+
+    std::vector<std::shared_ptr<MeshResource>> meshes;
+    for (std::size_t i = 0; i < Meshes; ++i) {
+        meshes.push_back(std::make_shared<MeshResource>(1000 + i, "mesh"));
+        fixture.renderer->Load(meshes.back());
+    }
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        fixture.WaitForRenderThread();
+        fixture.stub->ResetStats();
+        state.ResumeTiming();
+
+        for (std::size_t i = 0; i < Draws; ++i) {
+            // Scattered over the shaders and meshes like draws coming from a scene graph
+            const auto& shader = shaders[(i * 7) % Shaders];
+            const auto& mesh   = meshes[(i * 31) % Meshes];
+            fixture.renderer->Render(mesh, shader, {{"model", Matrix4(1.0f)}}, order);
+        }
+        fixture.renderer->EndFrame();
+        fixture.WaitForRenderThread();
+    }
+
+    const auto& stats                = fixture.stub->GetStats();
+    state.counters["draws"]          = static_cast<double>(stats.draws);
+    state.counters["instances"]      = static_cast<double>(stats.instances);
+    state.counters["shader_changes"] = static_cast<double>(stats.shader_changes);
+    state.counters["mesh_changes"]   = static_cast<double>(stats.mesh_changes);
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(Draws));
+}
+BENCHMARK(BM_RendererStateChanges)
+    ->ArgName("transparent")
+    ->Arg(static_cast<std::int64_t>(game_engine::RenderPass::Opaque))
+    ->Arg(static_cast<std::int64_t>(game_engine::RenderPass::Transparent))
+    ->UseRealTime();
+
+// Render thread lookup of a draw's mesh, by the hashed resource id the modules used to key their maps with
+void BM_RendererLookupResourceId(benchmark::State& state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+
+    std::unordered_map<game_engine::ResourceId, std::size_t> meshes;
+    std::vector<game_engine::ResourceId> draws;
+    for (std::size_t i = 0; i < count; ++i) {
+        const game_engine::ResourceId id = std::hash<std::string>{}("mesh_" + std::to_string(i));
+        meshes.emplace(id, i);
+        draws.push_back(id);
+    }
+
+    std::size_t sum = 0;
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < draws.size(); ++i) {
+            if (const auto it = meshes.find(draws[(i * 31) % draws.size()]); it != meshes.end()) {
+                sum += it->second;
+            }
+        }
+    }
+
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RendererLookupResourceId)->RangeMultiplier(8)->Range(64, 4096);
+
+// Same lookups through the generational handles the modules give out now
+void BM_RendererLookupHandle(benchmark::State& state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+
+    game_engine::graphics::HandleTable<std::size_t> meshes;
+    std::vector<game_engine::graphics::RenderHandle> draws;
+    for (std::size_t i = 0; i < count; ++i) {
+        draws.push_back(meshes.Insert(i));
+    }
+
+    std::size_t sum = 0;
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < draws.size(); ++i) {
+            if (const std::size_t* mesh = meshes.Get(draws[(i * 31) % draws.size()])) {
+                sum += *mesh;
+            }
+        }
+    }
+
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RendererLookupHandle)->RangeMultiplier(8)->Range(64, 4096);
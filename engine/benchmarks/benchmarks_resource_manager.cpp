@@ -0,0 +1,59 @@
+#include <string>
+#include <vector>
+
+#include <resource_management/resource_manager_impl.hpp>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+
+std::vector<std::string> MakeNames(std::int64_t count)
+{
+    std::vector<std::string> names;
+    for (std::int64_t i = 0; i < count; ++i) {
+        names.push_back("mesh_" + std::to_string(i));
+    }
+    return names;
+}
+
+} // namespace
+
+// Load and unload a set of meshes
+void BM_ResourceManagerLoadUnload(benchmark::State& state)
+{
+    game_engine::ResourceManagerImpl resource_manager;
+
+    const auto names = MakeNames(state.range(0));
+    for (auto _ : state) {
+        for (const auto& name : names) {
+            benchmark::DoNotOptimize(resource_manager.LoadMesh(name, {}));
+        }
+        for (const auto& name : names) {
+            resource_manager.Unload(name);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ResourceManagerLoadUnload)->Arg(16)->Arg(256);
+
+// Look up loaded meshes by name
+void BM_ResourceManagerGet(benchmark::State& state)
+{
+    game_engine::ResourceManagerImpl resource_manager;
+
+    const auto names = MakeNames(state.range(0));
+    for (const auto& name : names) {
+        resource_manager.LoadMesh(name, {});
+    }
+
+    for (auto _ : state) {
+        for (const auto& name : names) {
+            benchmark::DoNotOptimize(resource_manager.GetMesh(name));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ResourceManagerGet)->Arg(16)->Arg(256)->Arg(4096);
@@ -0,0 +1,41 @@
+#include <vector>
+
+#include <engine/common_types.hpp>
+#include <engine/graphics/vertex_traits.hpp>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+
+struct Vertex
+{
+    game_engine::Vector3 position;
+    game_engine::Vector3 normal;
+    game_engine::Vector2 uv;
+    game_engine::Vector4 color;
+};
+
+} // namespace
+
+// Convert a mesh of the given vertex count, bytes processed show the copy bandwidth
+void BM_ConvertToVertexData(benchmark::State& state)
+{
+    using namespace game_engine;
+
+    const std::vector<Vertex> vertices(static_cast<std::size_t>(state.range(0)));
+    const std::vector<VertexAttribute> attributes = {
+        vertex_traits::GenerateAttribute(0, "position", &Vertex::position),
+        vertex_traits::GenerateAttribute(1, "normal", &Vertex::normal),
+        vertex_traits::GenerateAttribute(2, "uv", &Vertex::uv),
+        vertex_traits::GenerateAttribute(3, "color", &Vertex::color),
+    };
+
+    for (auto _ : state) {
+        auto vertex_data = vertex_traits::ConvertToVertexData(vertices, attributes);
+        benchmark::DoNotOptimize(vertex_data.data.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<std::int64_t>(sizeof(Vertex)));
+}
+BENCHMARK(BM_ConvertToVertexData)->RangeMultiplier(16)->Range(1 << 10, 1 << 22)->Unit(benchmark::kMicrosecond);
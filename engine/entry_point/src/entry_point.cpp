@@ -2,6 +2,12 @@
     #include <windows.h>
 #endif
 
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+
 #include <engine/game.hpp>
 
 #include <modules/backend/backend_module.hpp>
@@ -22,10 +28,58 @@ int main(int argc, char* argv[])
     using namespace game_engine;
 
     try {
-        auto create_module_locator = []() {
+        std::filesystem::path record_events_file;
+        std::filesystem::path replay_events_file;
+        std::filesystem::path trace_file;
+        std::optional<BenchmarkSettings> benchmark;
+        std::filesystem::path benchmark_output_file = "benchmark.json"; // The engine logs to stdout
+
+#ifndef USE_WINMAIN_ENTRY
+        for (int i = 1; i < argc; ++i) {
+            const std::string_view option = argv[i];
+
+            const bool known = option == "--record-events" || option == "--replay-events" || option == "--trace" ||
+                               option == "--benchmark-frames" || option == "--benchmark-warmup" || option == "--benchmark-output";
+            if (!known) {
+                LOG_ERROR << "Unknown option: " << option << std::endl;
+                return -1;
+            }
+
+            // Every option takes a value
+            if (i + 1 >= argc) {
+                LOG_ERROR << "Missing value of option: " << option << std::endl;
+                return -1;
+            }
+
+            const char* value = argv[++i];
+            if (option == "--record-events") {
+                record_events_file = value;
+            } else if (option == "--replay-events") {
+                replay_events_file = value;
+            } else if (option == "--trace") {
+                trace_file = value;
+            } else if (option == "--benchmark-frames") {
+                benchmark         = benchmark.value_or(BenchmarkSettings{});
+                benchmark->frames = std::stoul(value);
+            } else if (option == "--benchmark-warmup") {
+                benchmark                = benchmark.value_or(BenchmarkSettings{});
+                benchmark->warmup_frames = std::stoul(value);
+            } else if (option == "--benchmark-output") {
+                benchmark             = benchmark.value_or(BenchmarkSettings{});
+                benchmark_output_file = value;
+            }
+        }
+#endif
+
+        auto create_module_locator = [&replay_events_file]() {
             ModuleLocator ml;
 
-            ml.SetImplementation(backend::IBackendModule::Create());
+            auto backend = backend::IBackendModule::Create();
+            if (!replay_events_file.empty() && !backend->ReplayEvents(replay_events_file)) {
+                throw std::runtime_error("Failed to replay events from " + replay_events_file.string());
+            }
+
+            ml.SetImplementation(std::move(backend));
             ml.SetImplementation(graphics::IRendererModule::Create());
             ml.SetImplementation(IGame::Create());
 
@@ -33,7 +87,31 @@ int main(int argc, char* argv[])
         };
 
         auto engine = std::make_shared<EngineImpl>(create_module_locator());
-        return engine->run();
+        if (!record_events_file.empty() && !engine->StartEventRecording(record_events_file)) {
+            return -1;
+        }
+
+        if (!trace_file.empty()) {
+            engine->SetTraceFile(trace_file);
+        }
+
+        if (!benchmark) {
+            return engine->run();
+        }
+
+        engine->EnableBenchmark(*benchmark);
+        if (const auto code = engine->run(); code != 0) {
+            return code;
+        }
+
+        std::ofstream output(benchmark_output_file, std::ios::trunc);
+        WriteBenchmarkJson(output, engine->GetBenchmarkResult());
+        if (!output) {
+            LOG_ERROR << "Failed to write benchmark result to " << benchmark_output_file << std::endl;
+            return -1;
+        }
+
+        return 0;
 
     } catch (std::exception& e) {
         LOG_ERROR << e.what() << std::endl;
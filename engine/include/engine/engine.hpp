@@ -4,6 +4,7 @@
 #include <memory>
 
 #include <engine/events/event_system.hpp>
+#include <engine/frame_stats.hpp>
 #include <engine/graphics/renderer.hpp>
 #include <engine/resource_management/resource_manager.hpp>
 
@@ -12,7 +13,6 @@ namespace game_engine
 
 // TODO: Add tests for mesh loading
 // TODO: Add ECS
-// TODO: Game in separate thread
 // TODO: Add rendering methods like in web canvas2d
 
 class IEngine
@@ -43,6 +43,12 @@ public:
 
     [[nodiscard]]
     virtual std::shared_ptr<EventSystem> GetEventSystem() const = 0;
+
+    /// @brief Gets the per-phase frame timings over the last one to two seconds.
+    /// Safe to call from any thread, collecting the timings is lock-free.
+    /// @return Min, average, max and 99th percentile durations of each FramePhase.
+    [[nodiscard]]
+    virtual FrameStats GetFrameStats() const = 0;
 };
 
 } // namespace game_engine
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <engine/utils/inplace_function.hpp>
+
+namespace game_engine
+{
+
+class EventSystem;
+
+/// @brief Defines what EventChannel::Post does when the ring buffer is full.
+enum class OverflowPolicy : std::uint8_t
+{
+    Block,      ///< The producer waits until the consumer frees a cell. Never post from the consumer thread with this policy.
+    DropOldest, ///< The oldest queued event is discarded to make room. Counted in EventChannelStats::dropped.
+    Grow,       ///< The event goes to a mutex-protected overflow list drained after the ring. Counted in EventChannelStats::overflowed.
+};
+
+struct EventChannelSettings
+{
+    std::size_t capacity          = 1024;                 ///< Ring capacity, rounded up to a power of two.
+    OverflowPolicy overflow_policy = OverflowPolicy::Block; ///< Behavior when the ring is full.
+};
+
+struct EventChannelStats
+{
+    std::uint64_t posted     = 0; ///< Events posted since creation.
+    std::uint64_t delivered  = 0; ///< Events handed to the consumer since creation.
+    std::uint64_t dropped    = 0; ///< Events discarded by OverflowPolicy::DropOldest.
+    std::uint64_t overflowed = 0; ///< Events stored in the overflow list by OverflowPolicy::Grow.
+    std::uint64_t queued     = 0; ///< Events waiting to be drained at the time of the call.
+};
+
+/// @brief Bounded lock-free multi-producer, single-consumer event channel.
+/// Any thread may post, one thread drains. Posting doesn't allocate, unless the ring overflows with OverflowPolicy::Grow.
+class EventChannel final
+{
+public:
+
+    /// @brief Size of the in-place storage of a posted delivery, in bytes.
+    static constexpr std::size_t DeliveryCapacity = 64;
+
+    /// @brief Type-erased posted event, delivers itself to the event system.
+    using Delivery = InplaceFunction<void(EventSystem&), DeliveryCapacity>;
+
+    explicit EventChannel(const EventChannelSettings& settings = {});
+    ~EventChannel();
+
+    EventChannel(const EventChannel&) = delete;
+    EventChannel(EventChannel&&)      = delete;
+
+    EventChannel& operator=(const EventChannel&) = delete;
+    EventChannel& operator=(EventChannel&&)      = delete;
+
+    /// @brief Posts a delivery. Safe to call from any thread.
+    /// @param delivery    The delivery to post.
+    void Post(Delivery delivery);
+
+    /// @brief Invokes queued deliveries in posting order. Must be called from a single consumer thread.
+    /// Drains at most one ring capacity worth of deliveries, so producers can't keep the consumer busy forever.
+    /// @param event_system    The event system to deliver to.
+    /// @returns               Number of delivered events.
+    std::size_t Drain(EventSystem& event_system);
+
+    /// @brief Returns the channel counters.
+    EventChannelStats GetStats() const noexcept;
+
+private:
+
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence{0};
+        Delivery delivery;
+    };
+
+    bool TryPush(Delivery& delivery);
+    bool TryPop(Delivery& delivery);
+
+    void PushOverflow(Delivery&& delivery);
+
+    const OverflowPolicy m_policy;
+    const std::size_t m_mask;
+    std::unique_ptr<Cell[]> m_cells;
+
+    alignas(64) std::atomic<std::size_t> m_enqueue_position{0};
+    alignas(64) std::atomic<std::size_t> m_dequeue_position{0};
+    alignas(64) std::atomic<std::uint32_t> m_waiting_producers{0};
+
+    std::atomic<bool> m_has_overflow{false};
+    std::mutex m_overflow_mutex;
+    std::vector<Delivery> m_overflow;
+
+    std::atomic<std::uint64_t> m_posted{0};
+    std::atomic<std::uint64_t> m_delivered{0};
+    std::atomic<std::uint64_t> m_dropped{0};
+    std::atomic<std::uint64_t> m_overflowed{0};
+};
+
+} // namespace game_engine
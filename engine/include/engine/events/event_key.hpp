@@ -0,0 +1,29 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+
+namespace game_engine
+{
+
+/// @brief Key extractor of an event type, enables keyed subscriptions with EventSystem::SubscribeKeyed.
+///
+/// Specializations provide:
+///  - `Key`                        the key type handlers subscribe to;
+///  - `KeyCount`                   the size of the dense handler table;
+///  - `IndexOf(const Key&)`        the table index of a key;
+///  - `IndexOf(const TEvent&)`     the table index of an event.
+/// Indices outside `[0, KeyCount)` are allowed for events and mean "no keyed handlers".
+template <typename TEvent>
+struct EventKeyTraits
+{};
+
+/// @brief Satisfied by event types that have an EventKeyTraits specialization.
+template <typename TEvent>
+concept KeyedEvent = requires(const TEvent& event, const typename EventKeyTraits<TEvent>::Key& key) {
+    { EventKeyTraits<TEvent>::KeyCount } -> std::convertible_to<std::size_t>;
+    { EventKeyTraits<TEvent>::IndexOf(key) } -> std::convertible_to<std::size_t>;
+    { EventKeyTraits<TEvent>::IndexOf(event) } -> std::convertible_to<std::size_t>;
+};
+
+} // namespace game_engine
@@ -1,12 +1,24 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <functional>
-#include <list>
 #include <memory>
 #include <mutex>
-#include <typeindex>
-#include <unordered_map>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+#include <engine/events/event_channel.hpp>
+#include <engine/events/event_key.hpp>
+#include <engine/events/window_events.hpp>
+#include <engine/utils/inplace_function.hpp>
+#include <engine/utils/profiler.hpp>
 
 namespace game_engine
 {
@@ -21,86 +33,256 @@ enum class HandlerPriority : std::uint8_t
 
 std::strong_ordering operator<=>(HandlerPriority a, HandlerPriority b) noexcept;
 
+/// @brief Defines when a handler receives events posted with EventSystem::Enqueue.
+enum class DeliveryMode : std::uint8_t
+{
+    Deferred  = 0, ///< Handler runs in batches during EventSystem::Flush.
+    Immediate = 1, ///< Handler runs synchronously inside EventSystem::Enqueue.
+};
+
+/// @brief Defines how events of one type waiting for EventSystem::Flush are combined.
+enum class CoalescePolicy : std::uint8_t
+{
+    None     = 0, ///< Every enqueued event is delivered.
+    KeepLast = 1, ///< A new event replaces the pending one, at most one event is delivered per flush.
+    Merge    = 2, ///< A new event is folded into the pending one by a reducer, at most one event is delivered per flush.
+};
+
 /// @brief Manages event subscriptions and dispatching. Thread-safe and supports multiple event types.
 class EventSystem final
 {
 public:
 
-    /// @brief Base class for event subscription. Unsubscribes automatically on destruction.
-    class ISubscription
-    {
-    public:
-
-        ISubscription()          = default;
-        virtual ~ISubscription() = default;
+    /// @brief Size of the in-place storage of a handler, in bytes. Bigger handlers don't compile.
+    static constexpr std::size_t HandlerCapacity = 64;
 
-        ISubscription(const ISubscription&) = delete;
-        ISubscription(ISubscription&&)      = default;
+    /// @brief Move-only handler type for events of type `TEvent`. Stored without heap allocation.
+    template <typename TEvent>
+    using Handler = InplaceFunction<void(const TEvent&), HandlerCapacity>;
 
-        ISubscription& operator=(const ISubscription&) = delete;
-        ISubscription& operator=(ISubscription&&)      = default;
+    /// @brief Folds the `next` event into the `pending` one, used with CoalescePolicy::Merge.
+    template <typename TEvent>
+    using Reducer = InplaceFunction<void(TEvent& pending, const TEvent& next), HandlerCapacity>;
 
-        /// @brief Unsubscribes the associated handler. Called automatically when the handle is destroyed.
-        virtual void Unsubscribe() const = 0;
+    /// @brief Generational handle of a subscribed handler. Stale handles are detected and ignored.
+    struct HandlerHandle
+    {
+        std::uint32_t index      = 0; ///< Slot index in the dispatcher slot map.
+        std::uint32_t generation = 0; ///< Slot generation at subscription time, 0 is never valid.
     };
 
-    using SubscriptionPtr = std::unique_ptr<ISubscription>;
+    class Subscription;
+
+    /// @brief Creates an event system with a default event channel.
+    EventSystem();
+
+    /// @brief Creates an event system whose event channel uses the given settings.
+    /// @param channel_settings    Capacity and overflow policy of the channel used by Post.
+    explicit EventSystem(const EventChannelSettings& channel_settings);
 
-    EventSystem() = default;
     ~EventSystem();
 
     /// @brief Subscribes a handler to events of type `Event`.
     /// @tparam Event      The event type to subscribe to.
     /// @param handler     Callback function to invoke when the event is dispatched.
     /// @param priority    Priority of the handler (default: HandlerPriority::Whenever).
+    /// @param mode        When the handler receives enqueued events (default: DeliveryMode::Deferred).
     /// @returns           A subscription handle for unsubscribing.
     template <typename TEvent>
     [[nodiscard]]
-    SubscriptionPtr Subscribe(std::function<void(const TEvent&)> handler, HandlerPriority priority = HandlerPriority::Whenever)
+    Subscription Subscribe(Handler<TEvent> handler,
+        HandlerPriority priority = HandlerPriority::Whenever,
+        DeliveryMode mode        = DeliveryMode::Deferred);
+
+    /// @brief Subscribes a handler to events of type `Event` with the given key.
+    /// Keyed handlers live in a dense table indexed by key, so dispatch only visits handlers bound
+    /// to the key of the event, plus the handlers subscribed with Subscribe. Priorities apply across both.
+    /// @tparam Event      The event type to subscribe to, must have an EventKeyTraits specialization.
+    /// @param key         The key to subscribe to. Throws std::out_of_range if it is outside the key table.
+    /// @param handler     Callback function to invoke when an event with this key is dispatched.
+    /// @param priority    Priority of the handler (default: HandlerPriority::Whenever).
+    /// @param mode        When the handler receives enqueued events (default: DeliveryMode::Deferred).
+    /// @returns           A subscription handle for unsubscribing.
+    template <KeyedEvent TEvent>
+    [[nodiscard]]
+    Subscription SubscribeKeyed(const typename EventKeyTraits<TEvent>::Key& key,
+        Handler<TEvent> handler,
+        HandlerPriority priority = HandlerPriority::Whenever,
+        DeliveryMode mode        = DeliveryMode::Deferred);
+
+    /// @brief Subscribes a handler to keyboard events with the given key code and action.
+    /// @param code        The key code to subscribe to.
+    /// @param action      The key action to subscribe to.
+    /// @param handler     Callback function to invoke when the key event is dispatched.
+    /// @param priority    Priority of the handler (default: HandlerPriority::Whenever).
+    /// @param mode        When the handler receives enqueued events (default: DeliveryMode::Deferred).
+    /// @returns           A subscription handle for unsubscribing.
+    [[nodiscard]]
+    Subscription SubscribeKey(KeyCode code,
+        KeyAction action,
+        Handler<KeyboardInputEvent> handler,
+        HandlerPriority priority = HandlerPriority::Whenever,
+        DeliveryMode mode        = DeliveryMode::Deferred);
+
+    /// @brief Subscribes a handler that only receives events accepted by the predicate.
+    /// The predicate and the handler are stored together, so both must fit into HandlerCapacity.
+    /// @tparam Event      The event type to subscribe to.
+    /// @param predicate   Callable `bool(const Event&)`, the handler is invoked only if it returns true.
+    /// @param handler     Callback function to invoke when an accepted event is dispatched.
+    /// @param priority    Priority of the handler (default: HandlerPriority::Whenever).
+    /// @param mode        When the handler receives enqueued events (default: DeliveryMode::Deferred).
+    /// @returns           A subscription handle for unsubscribing.
+    template <typename TEvent, typename TPredicate, typename THandler>
+    [[nodiscard]]
+    Subscription SubscribeIf(TPredicate predicate,
+        THandler handler,
+        HandlerPriority priority = HandlerPriority::Whenever,
+        DeliveryMode mode        = DeliveryMode::Deferred);
+
+    /// @brief Sets how enqueued events of type `Event` are combined until the next Flush.
+    /// Immediate handlers still receive every raw event, deferred handlers receive the combined one.
+    /// @tparam Event      The event type to configure.
+    /// @param policy      The coalescing policy.
+    /// @param reducer     Folds a new event into the pending one. Required for CoalescePolicy::Merge,
+    ///                    throws std::invalid_argument if missing. Runs under a lock, must not use the event system.
+    template <typename TEvent>
+    void SetCoalescing(CoalescePolicy policy, Reducer<TEvent> reducer = nullptr)
+    {
+        if (policy == CoalescePolicy::Merge && !reducer) {
+            throw std::invalid_argument("CoalescePolicy::Merge requires a reducer");
+        }
+
+        GetDispatcher<TEvent>().SetCoalescing(policy, std::move(reducer));
+    }
+
+    /// @brief Returns the number of enqueued events of type `Event` that were folded into a pending one.
+    /// @tparam Event      The event type to query.
+    template <typename TEvent>
+    std::uint64_t GetCoalescedCount() const noexcept
     {
-        return GetDispatcher<TEvent>()->Subscribe(std::move(handler), priority);
+        const auto* dispatcher = FindDispatcher<TEvent>();
+        return dispatcher != nullptr ? dispatcher->GetCoalescedCount() : 0;
     }
 
-    /// @brief Dispatches an event to all subscribed handlers of type `Event`.
+    /// @brief Dispatches an event to all subscribed handlers of type `Event` right away.
+    /// An event of a type that was never subscribed to is dropped.
     /// @tparam Event      The event type to process.
     /// @param event       The event object to dispatch.
     template <typename TEvent>
     void ProcessEvent(const TEvent& event)
     {
-        GetDispatcher<TEvent>()->ProcessEvent(event);
+        if (auto* dispatcher = FindDispatcher<TEvent>()) {
+            dispatcher->ProcessEvent(event);
+        }
+    }
+
+    /// @brief Queues an event until the next Flush. Immediate handlers are invoked right away.
+    /// An event of a type that was never subscribed to is dropped, handlers subscribed later don't receive it.
+    /// @tparam Event      The event type to enqueue.
+    /// @param event       The event object to enqueue.
+    template <typename TEvent>
+    void Enqueue(const TEvent& event)
+    {
+        auto* dispatcher = FindDispatcher<TEvent>();
+        if (dispatcher != nullptr && dispatcher->Enqueue(event)) {
+            std::lock_guard lock(m_queue_mutex);
+            m_queued_dispatchers.push_back(dispatcher);
+        }
     }
 
+    /// @brief Posts an event from any thread without locking. The event is enqueued on the flushing thread
+    /// at the start of the next Flush, so even immediate handlers run there.
+    /// The event is copied into the channel, so it must fit into EventChannel::DeliveryCapacity bytes.
+    /// Like Enqueue, it is dropped if its type was never subscribed to by the time of the flush.
+    /// @tparam Event      The event type to post.
+    /// @param event       The event object to post.
+    template <typename TEvent>
+    void Post(const TEvent& event)
+    {
+        static_assert(std::is_nothrow_move_constructible_v<TEvent>, "Posted events must be nothrow move constructible");
+        static_assert(sizeof(TEvent) <= EventChannel::DeliveryCapacity,
+            "Posted events must fit into EventChannel::DeliveryCapacity, post a handle to bigger data instead");
+        m_channel.Post([event](EventSystem& event_system) { event_system.Enqueue(event); });
+    }
+
+    /// @brief Dispatches all enqueued events to deferred handlers.
+    /// Events posted from other threads are enqueued first, in posting order.
+    /// Events are delivered type by type, in the order each type was first enqueued.
+    /// Events enqueued by handlers during the flush are delivered on the next flush.
+    void Flush();
+
+    /// @brief Returns the counters of the channel used by Post.
+    EventChannelStats GetChannelStats() const noexcept;
+
 private:
 
     class IDispatcherBase
     {
     public:
 
-        virtual ~IDispatcherBase()                   = default;
-        virtual bool HasHandlers() const             = 0;
-        virtual std::string GetEventTypeName() const = 0;
+        virtual ~IDispatcherBase()                     = default;
+        virtual bool HasHandlers() const               = 0;
+        virtual std::string GetEventTypeName() const   = 0;
+        virtual void Flush()                           = 0;
+        virtual void Unsubscribe(HandlerHandle handle) = 0;
     };
 
     template <typename TEvent>
     class Dispatcher;
 
+    using EventTypeId = std::uint32_t;
+
+    /// @brief Maximum number of distinct event types in the program.
+    static constexpr EventTypeId MaxEventTypes = 512;
+
+    /// @brief Assigns the next dense event type id. Throws if MaxEventTypes is exceeded.
+    static EventTypeId NextEventTypeId();
+
+    /// @brief Returns the dense id of the event type, assigned once on first use.
+    template <typename TEvent>
+    static EventTypeId GetEventTypeId()
+    {
+        static const EventTypeId s_id = NextEventTypeId();
+        return s_id;
+    }
+
+    /// @brief Returns the dispatcher for the event type, or nullptr if nobody ever subscribed to it.
     template <typename TEvent>
-    std::shared_ptr<Dispatcher<TEvent>> GetDispatcher()
+    Dispatcher<TEvent>* FindDispatcher() const noexcept
     {
-        const std::type_index type = typeid(TEvent);
+        return static_cast<Dispatcher<TEvent>*>(m_dispatcher_table[GetEventTypeId<TEvent>()].load(std::memory_order_acquire));
+    }
+
+    template <typename TEvent>
+    Dispatcher<TEvent>& GetDispatcher()
+    {
+        if (auto* dispatcher = FindDispatcher<TEvent>()) [[likely]] {
+            return *dispatcher;
+        }
 
         std::lock_guard lock(m_mutex);
-        if (auto it = m_dispatchers.find(type); it != m_dispatchers.end()) {
-            return std::static_pointer_cast<Dispatcher<TEvent>>(it->second);
+
+        // Another thread may have created it while we were waiting for the lock
+        auto& slot = m_dispatcher_table[GetEventTypeId<TEvent>()];
+        if (auto* dispatcher = slot.load(std::memory_order_acquire)) {
+            return *static_cast<Dispatcher<TEvent>*>(dispatcher);
         }
 
-        auto dispatcher     = std::make_shared<Dispatcher<TEvent>>();
-        m_dispatchers[type] = dispatcher;
-        return dispatcher;
+        auto dispatcher = std::make_shared<Dispatcher<TEvent>>();
+        m_dispatchers.push_back(dispatcher);
+        slot.store(dispatcher.get(), std::memory_order_release);
+
+        return *dispatcher;
     }
 
-    std::mutex m_mutex;
-    std::unordered_map<std::type_index, std::shared_ptr<IDispatcherBase>> m_dispatchers;
+    std::mutex m_mutex; ///< Guards dispatcher creation only.
+    std::vector<std::shared_ptr<IDispatcherBase>> m_dispatchers;
+    std::array<std::atomic<IDispatcherBase*>, MaxEventTypes> m_dispatcher_table{}; ///< Indexed by EventTypeId.
+
+    std::mutex m_queue_mutex;
+    std::vector<IDispatcherBase*> m_queued_dispatchers; ///< Dispatchers with pending events, in first-enqueue order.
+
+    EventChannel m_channel; ///< Events posted from any thread, drained by Flush.
 };
 
 } // namespace game_engine
@@ -108,6 +290,43 @@ private:
 namespace game_engine
 {
 
+/// @brief Subscription handle. Unsubscribes automatically on destruction.
+/// A small move-only value, creating one doesn't allocate.
+class EventSystem::Subscription final
+{
+public:
+
+    Subscription() noexcept = default;
+    ~Subscription();
+
+    Subscription(const Subscription&) = delete;
+    Subscription(Subscription&& other) noexcept;
+
+    Subscription& operator=(const Subscription&) = delete;
+    Subscription& operator=(Subscription&& other) noexcept;
+
+    /// @brief Unsubscribes the associated handler. Called automatically when the handle is destroyed.
+    void Unsubscribe();
+
+private:
+
+    friend class EventSystem;
+
+    Subscription(std::weak_ptr<IDispatcherBase> dispatcher, HandlerHandle handle) noexcept;
+
+    std::weak_ptr<IDispatcherBase> m_dispatcher;
+    HandlerHandle m_handle;
+};
+
+/// @brief Stores the handlers of one event type.
+///
+/// Handlers live in a paged slot map addressed by generational handles, so their storage never moves
+/// and is reused after unsubscribe. Dispatch order is kept in an immutable, priority-ordered vector of
+/// slot references that is replaced on every change (copy-on-write). Dispatch takes no lock and doesn't
+/// allocate, it only marks itself in flight. Replaced lists and handlers unsubscribed during a dispatch
+/// are recycled only when no dispatch is in flight, so readers never see them change.
+/// Keyed events also have one such vector per key in a dense table. Dispatch merges the vector of the
+/// event's key with the unkeyed one, so handlers bound to other keys are never visited.
 template <typename TEvent>
 class EventSystem::Dispatcher final
     : public IDispatcherBase
@@ -115,126 +334,470 @@ class EventSystem::Dispatcher final
 {
 public:
 
-    using Handler   = std::function<void(const TEvent&)>;
-    using HandlerId = std::size_t;
+    Dispatcher()
+    {
+        m_all.published = std::make_unique<HandlerList>();
+        m_all.handlers.store(m_all.published.get());
+
+        if constexpr (KeyedEvent<TEvent>) {
+            m_keyed = std::make_unique<std::array<Bucket, KeyCount>>();
+        }
+    }
+
+    ~Dispatcher() override = default;
 
-    struct HandlerNode
+    Dispatcher(const Dispatcher&) = delete;
+    Dispatcher(Dispatcher&&)      = delete;
+
+    Dispatcher& operator=(const Dispatcher&) = delete;
+    Dispatcher& operator=(Dispatcher&&)      = delete;
+
+    // IDispatcherBase
+    bool HasHandlers() const override
     {
-        HandlerId id;
-        Handler handler;
-        HandlerPriority priority;
+        std::lock_guard lock(m_mutex);
+        return !m_all.published->empty() || m_keyed_handlers_count != 0;
+    }
+
+    std::string GetEventTypeName() const override
+    {
+        return typeid(TEvent).name();
+    }
+
+    void Flush() override
+    {
+        std::vector<TEvent> batch;
+        {
+            std::lock_guard lock(m_queue_mutex);
+            batch.swap(m_queue);
+            m_queue.swap(m_spare_queue);
+        }
+
+        if (!batch.empty()) {
+            PROFILE_ZONE(typeid(TEvent).name());
+            Dispatch(batch, [](const Entry& entry) { return entry.mode == DeliveryMode::Deferred; });
+            batch.clear();
+        }
+
+        // Return the buffer, so steady-state flushing doesn't allocate
+        std::lock_guard lock(m_queue_mutex);
+        if (m_spare_queue.capacity() < batch.capacity()) {
+            m_spare_queue.swap(batch);
+        }
+    }
+
+    void Unsubscribe(HandlerHandle handle) override
+    {
+        std::unique_lock lock(m_mutex);
+
+        if (handle.generation == 0 || handle.index >= m_slot_count) {
+            return;
+        }
+
+        Slot& slot = SlotAt(handle.index);
+        if (slot.generation.load(std::memory_order_relaxed) != handle.generation) {
+            return; // Stale handle
+        }
+
+        Bucket& bucket = BucketAt(slot.bucket);
+        auto list      = AcquireList();
+        std::copy_if(bucket.published->begin(), bucket.published->end(), std::back_inserter(*list), [&slot](const Entry& entry) {
+            return entry.slot != &slot;
+        });
+        Publish(bucket, std::move(list));
+
+        if (slot.bucket != AllEvents) {
+            --m_keyed_handlers_count;
+        }
+
+        // From now on in-flight dispatches skip the handler
+        const std::uint32_t next_generation = handle.generation + 1;
+        slot.generation.store(next_generation != 0 ? next_generation : 1, std::memory_order_seq_cst);
+
+        m_retired_slots.push_back({&slot, handle.index});
+        m_has_retired_slots.store(true, std::memory_order_seq_cst);
+
+        ReclaimRetiredSlots(lock);
+    }
+
+    // Dispatcher methods
+    /// @brief Value of the `bucket` argument of Subscribe for handlers that receive every event.
+    static constexpr std::uint32_t AllEvents = ~std::uint32_t{0};
+
+    /// @param bucket    Key index of a keyed handler, or AllEvents.
+    Subscription Subscribe(Handler<TEvent>&& handler, HandlerPriority priority, DeliveryMode mode, std::uint32_t bucket = AllEvents)
+    {
+        std::unique_lock lock(m_mutex);
+        ReclaimRetiredSlots(lock);
+
+        const std::uint32_t index = AcquireSlot();
+        Slot& slot                = SlotAt(index);
+        slot.handler              = std::move(handler);
+        slot.bucket               = bucket;
+
+        const std::uint32_t generation = slot.generation.load(std::memory_order_relaxed);
+        const Entry entry{&slot, m_next_order++, generation, priority, mode};
+
+        Bucket& target = BucketAt(bucket);
+        if (!target.published) {
+            target.published = std::make_unique<HandlerList>();
+        }
+
+        const auto& current = *target.published;
+        const auto position = std::lower_bound(current.begin(), current.end(), entry, &EntryLess);
+
+        auto list = AcquireList();
+        list->reserve(current.size() + 1);
+        list->insert(list->end(), current.begin(), position);
+        list->push_back(entry);
+        list->insert(list->end(), position, current.end());
+        Publish(target, std::move(list));
+
+        if (bucket != AllEvents) {
+            ++m_keyed_handlers_count;
+        }
+
+        return Subscription(this->weak_from_this(), {index, generation});
+    }
+
+    /// @brief Dispatches the event to all handlers without locking or allocating.
+    void ProcessEvent(const TEvent& event)
+    {
+        Dispatch(std::span(&event, 1), [](const Entry&) { return true; });
+    }
+
+    /// @brief Runs immediate handlers and queues the event for the next flush, coalescing it if configured.
+    /// @returns True if this is the first queued event since the last flush.
+    bool Enqueue(const TEvent& event)
+    {
+        Dispatch(std::span(&event, 1), [](const Entry& entry) { return entry.mode == DeliveryMode::Immediate; });
+
+        std::lock_guard lock(m_queue_mutex);
+        if (m_coalesce_policy != CoalescePolicy::None && !m_queue.empty()) {
+            if (m_coalesce_policy == CoalescePolicy::KeepLast) {
+                m_queue.back() = event;
+            } else {
+                m_reducer(m_queue.back(), event);
+            }
+
+            m_coalesced_count.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        m_queue.push_back(event);
+        return m_queue.size() == 1;
+    }
+
+    void SetCoalescing(CoalescePolicy policy, Reducer<TEvent>&& reducer)
+    {
+        std::lock_guard lock(m_queue_mutex);
+        m_coalesce_policy = policy;
+        m_reducer         = std::move(reducer);
+    }
+
+    std::uint64_t GetCoalescedCount() const noexcept
+    {
+        return m_coalesced_count.load(std::memory_order_relaxed);
+    }
+
+private:
+
+    static constexpr std::uint32_t PageSize = 64;
+
+    struct Slot
+    {
+        Handler<TEvent> handler;
+        std::atomic<std::uint32_t> generation{1};
+        std::uint32_t bucket = AllEvents; ///< Key index of a keyed handler, guarded by m_mutex.
     };
 
-    class SubscriptionImpl final : public ISubscription
+    using Page = std::array<Slot, PageSize>;
+
+    struct Entry
     {
-    public:
+        Slot* slot;               ///< Stable pointer into the slot map.
+        std::uint64_t order;      ///< Subscription order, keeps handlers of equal priority in FIFO order.
+        std::uint32_t generation; ///< Slot generation the entry was created for.
+        HandlerPriority priority;
+        DeliveryMode mode;
+    };
 
-        SubscriptionImpl(std::weak_ptr<Dispatcher> dispatcher, HandlerId id)
-            : m_dispatcher(std::move(dispatcher))
-            , m_id(id)
-        {}
+    /// @brief Immutable, priority-ordered list of handlers. Replaced as a whole on every change.
+    using HandlerList = std::vector<Entry>;
 
-        ~SubscriptionImpl() override
-        {
-            Unsubscribe();
+    /// @brief Published handler list of all events or of one key.
+    struct Bucket
+    {
+        std::atomic<const HandlerList*> handlers{nullptr}; ///< Published snapshot, read by dispatch.
+        std::unique_ptr<HandlerList> published;            ///< Owner of the published snapshot.
+    };
+
+    static constexpr std::size_t KeyCount = [] {
+        if constexpr (KeyedEvent<TEvent>) {
+            return static_cast<std::size_t>(EventKeyTraits<TEvent>::KeyCount);
+        } else {
+            return std::size_t{0};
         }
+    }();
 
-        SubscriptionImpl(const SubscriptionImpl&) = delete;
-        SubscriptionImpl(SubscriptionImpl&&)      = default;
+    struct RetiredSlot
+    {
+        Slot* slot;
+        std::uint32_t index;
+    };
 
-        SubscriptionImpl& operator=(const SubscriptionImpl&) = delete;
-        SubscriptionImpl& operator=(SubscriptionImpl&&)      = default;
+    /// @brief Marks a dispatch in flight. The last dispatch to leave releases retired handlers if the lock is free.
+    class DispatchScope final
+    {
+    public:
 
-        void Unsubscribe() const override
+        explicit DispatchScope(Dispatcher& dispatcher) noexcept
+            : m_dispatcher(dispatcher)
         {
-            if (auto dispatcher = m_dispatcher.lock()) {
-                dispatcher->Unsubscribe(m_id);
+            m_dispatcher.m_active_dispatches.fetch_add(1, std::memory_order_seq_cst);
+        }
+
+        ~DispatchScope()
+        {
+            if (m_dispatcher.m_active_dispatches.fetch_sub(1, std::memory_order_seq_cst) == 1 &&
+                m_dispatcher.m_has_retired_slots.load(std::memory_order_seq_cst)) {
+                // If the lock is busy the slots stay retired, reclaiming is deferred to the next Subscribe,
+                // Unsubscribe or last dispatch to leave
+                std::unique_lock lock(m_dispatcher.m_mutex, std::try_to_lock);
+                if (lock.owns_lock()) {
+                    m_dispatcher.ReclaimRetiredSlots(lock);
+                }
             }
         }
 
+        DispatchScope(const DispatchScope&) = delete;
+        DispatchScope(DispatchScope&&)      = delete;
+
+        DispatchScope& operator=(const DispatchScope&) = delete;
+        DispatchScope& operator=(DispatchScope&&)      = delete;
+
     private:
 
-        std::weak_ptr<Dispatcher> m_dispatcher;
-        HandlerId m_id;
+        Dispatcher& m_dispatcher;
     };
 
-    bool HasHandlers() const override
+    static bool EntryLess(const Entry& a, const Entry& b) noexcept
     {
-        std::lock_guard lock(m_mutex);
-        return !m_handlers.empty();
+        if (a.priority == b.priority) {
+            return a.order < b.order;
+        }
+        return a.priority > b.priority;
     }
 
-    std::string GetEventTypeName() const override
+    template <typename TFilter>
+    void Dispatch(std::span<const TEvent> events, TFilter&& filter)
     {
-        return typeid(TEvent).name();
+        const DispatchScope scope(*this);
+        const HandlerList* handlers = m_all.handlers.load(std::memory_order_seq_cst);
+
+        for (const auto& event : events) {
+            if constexpr (KeyedEvent<TEvent>) {
+                if (const HandlerList* keyed = FindKeyedHandlers(event); keyed != nullptr && !keyed->empty()) {
+                    DispatchMerged(event, *handlers, *keyed, filter);
+                    continue;
+                }
+            }
+
+            for (const auto& entry : *handlers) {
+                Invoke(entry, event, filter);
+            }
+        }
     }
 
-    SubscriptionPtr Subscribe(Handler&& handler, HandlerPriority priority)
+    /// @brief Invokes handlers of two priority-ordered lists in their combined order.
+    template <typename TFilter>
+    static void DispatchMerged(const TEvent& event, const HandlerList& a, const HandlerList& b, TFilter& filter)
     {
-        std::lock_guard lock(m_mutex);
-        HandlerId id = m_next_id++;
+        auto first  = a.begin();
+        auto second = b.begin();
+
+        while (first != a.end() && second != b.end()) {
+            if (EntryLess(*second, *first)) {
+                Invoke(*second++, event, filter);
+            } else {
+                Invoke(*first++, event, filter);
+            }
+        }
 
-        std::ignore = AddHandler({id, std::move(handler), priority});
-        return std::make_unique<SubscriptionImpl>(this->weak_from_this(), id);
+        for (; first != a.end(); ++first) {
+            Invoke(*first, event, filter);
+        }
+        for (; second != b.end(); ++second) {
+            Invoke(*second, event, filter);
+        }
     }
 
-    void Unsubscribe(HandlerId id)
+    template <typename TFilter>
+    static void Invoke(const Entry& entry, const TEvent& event, TFilter& filter)
     {
-        std::lock_guard lock(m_mutex);
-        if (auto map_it = m_handlers_map.find(id); map_it != m_handlers_map.end()) {
-            m_handlers.erase(map_it->second);
-            m_handlers_map.erase(map_it);
+        if (filter(entry) && entry.slot->generation.load(std::memory_order_seq_cst) == entry.generation) {
+            entry.slot->handler(event);
         }
     }
 
-    void ProcessEvent(const TEvent& event) const
+    const HandlerList* FindKeyedHandlers(const TEvent& event) const noexcept
     {
-        std::list<HandlerNode> handlers_copy;
-        {
-            std::lock_guard lock(m_mutex);
-            handlers_copy = m_handlers;
+        const std::size_t index = EventKeyTraits<TEvent>::IndexOf(event);
+        if (index >= KeyCount) {
+            return nullptr;
         }
 
-        for (const auto& node : handlers_copy) {
-            try {
-                if (node.handler) {
-                    node.handler(event);
-                }
-            } catch (...) {
-                // TODO: Error handling
-                throw std::current_exception();
+        return (*m_keyed)[index].handlers.load(std::memory_order_seq_cst);
+    }
+
+    // The methods below must be called with m_mutex locked.
+
+    Bucket& BucketAt(std::uint32_t bucket) noexcept
+    {
+        if constexpr (KeyedEvent<TEvent>) {
+            if (bucket != AllEvents) {
+                return (*m_keyed)[bucket];
             }
         }
+
+        return m_all;
     }
 
-private:
+    Slot& SlotAt(std::uint32_t index) noexcept
+    {
+        return (*m_pages[index / PageSize])[index % PageSize];
+    }
 
-    auto AddHandler(HandlerNode&& node)
+    std::uint32_t AcquireSlot()
     {
-        auto it = std::lower_bound(m_handlers.begin(), m_handlers.end(), node, [](const HandlerNode& a, const HandlerNode& b) {
-            if (a.priority == b.priority) {
-                return a.id < b.id;
+        if (!m_free_slots.empty()) {
+            const std::uint32_t index = m_free_slots.back();
+            m_free_slots.pop_back();
+            return index;
+        }
+
+        if (m_slot_count % PageSize == 0) {
+            m_pages.push_back(std::make_unique<Page>());
+        }
+
+        return m_slot_count++;
+    }
+
+    /// @brief Returns an empty list for the next snapshot, reusing a replaced one if no dispatch can read it.
+    std::unique_ptr<HandlerList> AcquireList()
+    {
+        if (!m_retired_lists.empty() && m_active_dispatches.load(std::memory_order_seq_cst) == 0) {
+            for (auto& list : m_retired_lists) {
+                if (m_spare_lists.size() < MaxSpareLists) {
+                    m_spare_lists.push_back(std::move(list));
+                }
             }
-            return a.priority > b.priority;
-        });
+            m_retired_lists.clear();
+        }
+
+        if (!m_spare_lists.empty()) {
+            auto list = std::move(m_spare_lists.back());
+            m_spare_lists.pop_back();
+            list->clear();
+            return list;
+        }
+
+        return std::make_unique<HandlerList>();
+    }
 
-        auto inserted = m_handlers.insert(it, std::move(node));
+    void Publish(Bucket& bucket, std::unique_ptr<HandlerList> list)
+    {
+        bucket.handlers.store(list.get(), std::memory_order_seq_cst);
 
-        try {
-            m_handlers_map.emplace(inserted->id, inserted);
-        } catch (...) {
-            // Rollback: Remove from the list if map insertion failed
-            m_handlers.erase(inserted);
-            throw;
+        // In-flight dispatches may still iterate the previous list
+        m_retired_lists.push_back(std::exchange(bucket.published, std::move(list)));
+    }
+
+    /// @brief Releases handlers of unsubscribed slots once no dispatch can be running them.
+    /// Handlers are destroyed with the lock released, so their destructors may use the event system.
+    void ReclaimRetiredSlots(std::unique_lock<std::mutex>& lock)
+    {
+        if (m_reclaiming || m_retired_slots.empty() || m_active_dispatches.load(std::memory_order_seq_cst) != 0) {
+            return;
         }
 
-        return inserted;
+        m_reclaiming = true;
+        std::swap(m_retired_slots, m_reclaimed_slots);
+        m_has_retired_slots.store(false, std::memory_order_seq_cst);
+
+        lock.unlock();
+        for (const auto& retired : m_reclaimed_slots) {
+            retired.slot->handler.Reset();
+        }
+        lock.lock();
+
+        for (const auto& retired : m_reclaimed_slots) {
+            m_free_slots.push_back(retired.index);
+        }
+        m_reclaimed_slots.clear();
+        m_reclaiming = false;
     }
 
-    mutable std::mutex m_mutex;
-    std::list<HandlerNode> m_handlers;
-    std::unordered_map<HandlerId, typename std::list<HandlerNode>::iterator> m_handlers_map;
-    HandlerId m_next_id{1};
+    static constexpr std::size_t MaxSpareLists = 2;
+
+    mutable std::mutex m_mutex; ///< Serializes writers only, dispatch never takes it.
+
+    std::vector<std::unique_ptr<Page>> m_pages;
+    std::uint32_t m_slot_count = 0;
+    std::vector<std::uint32_t> m_free_slots;
+    std::vector<RetiredSlot> m_retired_slots;   ///< Unsubscribed, waiting for in-flight dispatches to finish.
+    std::vector<RetiredSlot> m_reclaimed_slots; ///< Being released by ReclaimRetiredSlots.
+    bool m_reclaiming = false;
+
+    std::atomic<std::uint32_t> m_active_dispatches{0};
+    std::atomic<bool> m_has_retired_slots{false};
+
+    Bucket m_all;                                              ///< Handlers of every event.
+    std::unique_ptr<std::array<Bucket, KeyCount>> m_keyed;     ///< Handlers by key index, keyed events only.
+    std::size_t m_keyed_handlers_count = 0;                    ///< Number of handlers in m_keyed.
+    std::vector<std::unique_ptr<HandlerList>> m_retired_lists; ///< Replaced snapshots, may still be read by dispatches.
+    std::vector<std::unique_ptr<HandlerList>> m_spare_lists;   ///< Replaced snapshots no dispatch can see.
+    std::uint64_t m_next_order = 0;
+
+    std::mutex m_queue_mutex;
+    std::vector<TEvent> m_queue;       ///< Events waiting for the next flush.
+    std::vector<TEvent> m_spare_queue; ///< Recycled buffer, swapped in when a flush starts.
+    CoalescePolicy m_coalesce_policy = CoalescePolicy::None;
+    Reducer<TEvent> m_reducer;
+    std::atomic<std::uint64_t> m_coalesced_count{0}; ///< Events folded into a pending one since creation.
 };
 
+template <typename TEvent>
+EventSystem::Subscription EventSystem::Subscribe(Handler<TEvent> handler, HandlerPriority priority, DeliveryMode mode)
+{
+    return GetDispatcher<TEvent>().Subscribe(std::move(handler), priority, mode);
+}
+
+template <KeyedEvent TEvent>
+EventSystem::Subscription EventSystem::SubscribeKeyed(const typename EventKeyTraits<TEvent>::Key& key,
+    Handler<TEvent> handler,
+    HandlerPriority priority,
+    DeliveryMode mode)
+{
+    const std::size_t index = EventKeyTraits<TEvent>::IndexOf(key);
+    if (index >= EventKeyTraits<TEvent>::KeyCount) {
+        throw std::out_of_range("Event key is outside the key table");
+    }
+
+    return GetDispatcher<TEvent>().Subscribe(std::move(handler), priority, mode, static_cast<std::uint32_t>(index));
+}
+
+template <typename TEvent, typename TPredicate, typename THandler>
+EventSystem::Subscription EventSystem::SubscribeIf(TPredicate predicate, THandler handler, HandlerPriority priority, DeliveryMode mode)
+{
+    return Subscribe<TEvent>(
+        [predicate = std::move(predicate), handler = std::move(handler)](const TEvent& event) mutable {
+            if (std::invoke(predicate, event)) {
+                std::invoke(handler, event);
+            }
+        },
+        priority,
+        mode);
+}
+
 } // namespace game_engine
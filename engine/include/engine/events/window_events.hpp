@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstddef>
+
+#include <engine/events/event_key.hpp>
 #include <engine/input/keyboard.hpp>
 
 namespace game_engine
@@ -12,6 +15,35 @@ struct KeyboardInputEvent
     KeyModifier modifiers = KeyModifier::None; ///< The modifiers active during the event.
 };
 
+/// @brief Keys keyboard events by key code and action, see EventSystem::SubscribeKey.
+template <>
+struct EventKeyTraits<KeyboardInputEvent>
+{
+    struct Key
+    {
+        KeyCode code     = KeyCode::Unknown;
+        KeyAction action = KeyAction::None;
+    };
+
+    static constexpr std::size_t ActionCount = static_cast<std::size_t>(KeyAction::Repeat) + 1;
+    static constexpr std::size_t KeyCount    = (static_cast<std::size_t>(KeyCode::Menu) + 1) * ActionCount;
+
+    static constexpr std::size_t IndexOf(const Key& key) noexcept
+    {
+        const auto action = static_cast<std::size_t>(key.action);
+        if (action >= ActionCount) {
+            return KeyCount;
+        }
+
+        return static_cast<std::size_t>(key.code) * ActionCount + action;
+    }
+
+    static constexpr std::size_t IndexOf(const KeyboardInputEvent& event) noexcept
+    {
+        return IndexOf(Key{event.key, event.action});
+    }
+};
+
 struct WindowResizeEvent
 {
     int width  = 0; ///< The new width of the window, in screen coordinates.
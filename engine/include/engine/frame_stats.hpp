@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <engine/graphics/render_lane.hpp>
+
+namespace game_engine
+{
+
+/// @brief Measured parts of a frame.
+enum class FramePhase : std::uint8_t
+{
+    PollEvents,      ///< Backend event polling and event system flush.
+    Update,          ///< One IGame::OnUpdate call.
+    Draw,            ///< IGame::OnDraw call.
+    Submit,          ///< IRenderer::EndFrame on the main thread, hands the frame over to the render thread.
+    Stall,           ///< Part of Submit spent waiting for a frame in flight to finish, only recorded when it waits.
+    Upload,          ///< One IRenderer::LoadAsync upload on the render thread.
+    RenderExecution, ///< Execution of the frame commands on the render thread.
+    SwapBuffers,     ///< Buffer swap on the render thread.
+    Frame,           ///< Main loop iteration that drew a frame, without the wait for the next deadline.
+};
+
+inline constexpr std::size_t FramePhaseCount = static_cast<std::size_t>(FramePhase::Frame) + 1;
+
+/// @brief Timings of one phase over the last one to two seconds.
+struct PhaseTimings
+{
+    std::chrono::nanoseconds min{};
+    std::chrono::nanoseconds average{};
+    std::chrono::nanoseconds max{};
+    std::chrono::nanoseconds p50{}; ///< Median, percentiles are accurate to 1/8 of their value.
+    std::chrono::nanoseconds p90{}; ///< 90th percentile.
+    std::chrono::nanoseconds p99{}; ///< 99th percentile.
+    std::uint64_t samples = 0;
+};
+
+/// @brief Rolling frame statistics, see IEngine::GetFrameStats.
+struct FrameStats
+{
+    std::array<PhaseTimings, FramePhaseCount> phases{};
+
+    std::size_t updates_per_second = 0; ///< Updates done in the last full second.
+    std::size_t frames_per_second  = 0; ///< Frames drawn in the last full second.
+
+    std::size_t frames_in_flight     = 0; ///< Frames queued or rendering when the last frame was submitted.
+    std::size_t max_frames_in_flight = 0; ///< Most frames in flight over the last one to two seconds.
+    std::uint64_t skipped_frames     = 0; ///< Frames dropped by FrameBackpressure::SkipFrame since the start.
+
+    std::size_t draw_calls = 0; ///< Draw calls the last rendered frame issued to the GPU.
+
+    std::uint64_t state_changes         = 0; ///< GPU state calls the last rendered frame issued.
+    std::uint64_t skipped_state_changes = 0; ///< Redundant state calls the last rendered frame skipped.
+
+    std::array<PhaseTimings, RenderLaneCount> queue_latency{}; ///< Time the render thread tasks waited in their lane.
+
+    const PhaseTimings& operator[](FramePhase phase) const noexcept
+    {
+        return phases[static_cast<std::size_t>(phase)];
+    }
+
+    const PhaseTimings& operator[](RenderLane lane) const noexcept
+    {
+        return queue_latency[static_cast<std::size_t>(lane)];
+    }
+};
+
+} // namespace game_engine
@@ -9,6 +9,14 @@
 namespace game_engine
 {
 
+/// @brief Game callbacks invoked by the engine.
+///
+/// Thread contract:
+///  - Init, Shutdown, OnDraw, OnShouldClose, OnSync and event handlers run on the main thread.
+///  - OnUpdate runs on the main thread with ThreadingMode::SingleThreaded, and on the simulation thread with
+///    ThreadingMode::SimulationThread. In the latter case OnUpdate overlaps with OnDraw of the previous state,
+///    so OnDraw must only read state published in OnSync.
+///  - OnSync, event handlers and OnShouldClose never overlap with OnUpdate.
 class IGame
 {
 public:
@@ -27,6 +35,11 @@ public:
     /// @brief Called every frame to render the game.
     virtual void OnDraw() = 0;
 
+    /// @brief Called after a batch of updates, before the frame that shows them is drawn.
+    /// Neither OnUpdate nor OnDraw is running, copy the state OnDraw needs here.
+    virtual void OnSync()
+    {}
+
     /// @brief Checks if the game should close.
     /// @return True if the game should close, false otherwise.
     virtual bool OnShouldClose() = 0;
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <chrono>
+#include <cstddef>
 #include <string>
 
+#include <engine/graphics/render_lane.hpp>
+
 namespace game_engine
 {
 enum class DisplayMode
@@ -19,6 +23,34 @@ enum class AntiAliasing
     MSAA8x,
 };
 
+/// @brief Defines how the main loop waits for the next update or frame.
+enum class FramePacing
+{
+    LowLatency, ///< Sleeps until shortly before the deadline and spins for the rest, wakes up on time.
+    LowPower,   ///< Only sleeps, wake-ups may be late by the OS timer resolution.
+};
+
+/// @brief Defines which threads run the game callbacks, see IGame.
+enum class ThreadingMode
+{
+    SingleThreaded,   ///< Updates and drawing run one after the other on the main thread.
+    SimulationThread, ///< Updates run on a dedicated thread, overlapping with drawing the previous state.
+};
+
+/// @brief Defines what IRenderer::EndFrame does when the render thread is max_frames_in_flight frames behind.
+enum class FrameBackpressure
+{
+    Block,     ///< Waits for the oldest frame to be presented, the main loop slows down to the render thread.
+    SkipFrame, ///< Drops the new frame, the main loop keeps its pace and the screen shows fewer frames.
+};
+
+/// @brief Defines the order of the draw calls in RenderPass::Transparent.
+enum class TransparentSorting
+{
+    SubmissionOrder, ///< Keeps the order of the IRenderer::Render calls.
+    BackToFront,     ///< Sorts by DrawOrder::depth, farthest first.
+};
+
 struct GameSettings
 {
     int resolution_width       = 1600;
@@ -29,6 +61,30 @@ struct GameSettings
     DisplayMode display_mode   = DisplayMode::Windowed;
     AntiAliasing anti_aliasing = AntiAliasing::None;
     bool v_sync                = false;
+    FramePacing frame_pacing   = FramePacing::LowLatency;
+    ThreadingMode threading    = ThreadingMode::SingleThreaded;
+
+    /// Frames handed to the render thread and not yet presented, at most. Bounds the input latency.
+    int max_frames_in_flight             = 2;
+    FrameBackpressure frame_backpressure = FrameBackpressure::Block;
+
+    TransparentSorting transparent_sorting = TransparentSorting::SubmissionOrder;
+
+    /// Merges consecutive draws of the same mesh and shader that differ only in the "model" matrix into instanced draws.
+    /// Off by default, it changes how every draw of such a run reaches the shader.
+    bool automatic_instancing = false;
+
+    /// Lane of the IRenderer::LoadAsync uploads. Only RenderLane::Background uploads are limited by the budget below
+    /// and wait for the frames queued before them.
+    RenderLane upload_lane = RenderLane::Background;
+
+    /// Budget of the background uploads done by the render thread per frame, it stops after the resource that
+    /// exceeds either limit. At least one resource is uploaded per frame.
+    std::size_t upload_bytes_per_frame              = 4 * 1024 * 1024;
+    std::chrono::microseconds upload_time_per_frame = std::chrono::microseconds(2000);
+
+    /// Time before a deadline spent spinning instead of sleeping, with FramePacing::LowLatency.
+    std::chrono::microseconds pacing_spin_threshold = std::chrono::microseconds(1500);
 
     friend bool operator==(const GameSettings& lhs, const GameSettings& rhs) = default;
 };
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <variant>
 
 #include <engine/common_types.hpp>
@@ -18,4 +20,43 @@ struct Property
     PropertyValue value;
 };
 
+/// @brief Interned property name. Equal names get equal ids, comparing and looking up ids doesn't touch strings.
+/// Creating an id takes a lock, create them once, e.g. in IGame::Init, and reuse them for every draw.
+class PropertyId final
+{
+public:
+
+    PropertyId() = default;
+    explicit PropertyId(std::string_view name);
+
+    /// @brief Returns the dense index of the id, starting from 1, 0 for the default constructed id.
+    std::uint32_t GetIndex() const noexcept
+    {
+        return m_index;
+    }
+
+    /// @brief Returns the interned name, it lives until the end of the program.
+    const char* GetName() const noexcept
+    {
+        return m_name;
+    }
+
+    friend bool operator==(const PropertyId& lhs, const PropertyId& rhs) noexcept
+    {
+        return lhs.m_index == rhs.m_index;
+    }
+
+private:
+
+    std::uint32_t m_index = 0;
+    const char* m_name    = "";
+};
+
+/// @brief Property addressed by an interned id, see IRenderer::Render.
+struct PropertyBinding
+{
+    PropertyId id;
+    PropertyValue value;
+};
+
 } // namespace game_engine
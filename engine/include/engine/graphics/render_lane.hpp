@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace game_engine
+{
+
+/// @brief Queues of the render thread, in priority order. A task runs only when the lanes before its own are empty.
+enum class RenderLane : std::uint8_t
+{
+    Frame,      ///< Frames handed over by IRenderer::EndFrame.
+    Critical,   ///< Work the main thread waits for, like IRenderer::Load.
+    Background, ///< IRenderer::LoadAsync uploads, limited to the per-frame upload budget.
+};
+
+inline constexpr std::size_t RenderLaneCount = static_cast<std::size_t>(RenderLane::Background) + 1;
+
+} // namespace game_engine
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <span>
 #include <vector>
 
 #include <engine/graphics/material.hpp>
@@ -11,6 +14,26 @@
 namespace game_engine
 {
 
+/// @brief Groups of draw calls, executed one after another in this order.
+enum class RenderPass : std::uint8_t
+{
+    Opaque,      ///< Sorted to minimize state changes, then front to back.
+    Transparent, ///< Ordered according to TransparentSorting.
+};
+
+/// @brief Ordering hints of a draw call.
+struct DrawOrder
+{
+    RenderPass pass = RenderPass::Opaque;
+    float depth     = 0.0f; ///< Distance from the camera, negative values count as zero.
+};
+
+/// @brief Called on the main thread when an IRenderer::LoadAsync upload is done.
+/// @param loaded    False if the upload failed.
+using LoadCallback = std::function<void(bool loaded)>;
+
+/// @brief Records draw calls and hands them over to the render thread.
+/// Call it from the main thread only (IGame::Init, OnDraw and OnSync), not from OnUpdate.
 class IRenderer
 {
 public:
@@ -21,9 +44,33 @@ public:
     virtual bool Load(const std::shared_ptr<IShader>& shader)   = 0;
     virtual bool Load(const std::shared_ptr<ITexture>& texture) = 0;
 
+    /// @brief Queues the upload without waiting for it, the render thread uploads the queued resources over the
+    /// next frames in the time the frames leave, within the per-frame budget of GameSettings. The resource is
+    /// LoadedInGPU and can be drawn once the callback is called from EndFrame. Already loaded resources call it
+    /// right away.
+    /// Callbacks of uploads still queued when the renderer shuts down are not called.
+    virtual void LoadAsync(const std::shared_ptr<IMesh>& mesh, LoadCallback callback)       = 0;
+    virtual void LoadAsync(const std::shared_ptr<IShader>& shader, LoadCallback callback)   = 0;
+    virtual void LoadAsync(const std::shared_ptr<ITexture>& texture, LoadCallback callback) = 0;
+
     virtual void Render(const std::shared_ptr<IMesh>& mesh, const std::shared_ptr<IShader>& shader, std::vector<Property> properties) = 0;
     virtual void Render(const std::shared_ptr<IMesh>& mesh, const std::shared_ptr<IMaterial>& material)                               = 0;
 
+    /// @brief Records a draw call, the frame's draw calls are executed in the order given by the pass and depth,
+    /// not in the order of the calls. Convenience overload, interns the property names on every call.
+    /// Draws of a mesh or shader that isn't loaded are skipped, silently while its LoadAsync upload is queued.
+    virtual void Render(const std::shared_ptr<IMesh>& mesh,
+                        const std::shared_ptr<IShader>& shader,
+                        std::vector<Property> properties,
+                        const DrawOrder& order) = 0;
+
+    /// @brief Records a draw call like the overload above, without allocating or hashing property names.
+    /// The values are packed into the frame's property buffer, the span isn't used after the call.
+    virtual void Render(const std::shared_ptr<IMesh>& mesh,
+                        const std::shared_ptr<IShader>& shader,
+                        std::span<const PropertyBinding> properties,
+                        const DrawOrder& order) = 0;
+
     virtual void EndFrame() = 0;
 };
 
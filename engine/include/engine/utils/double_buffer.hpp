@@ -0,0 +1,45 @@
+#pragma once
+
+namespace game_engine
+{
+
+/// @brief Two copies of a state, one written by the simulation and one read by drawing.
+/// Publish copies the written state to the read one, call it from IGame::OnSync.
+/// @tparam TState    Copy-assignable state type.
+template <typename TState>
+class DoubleBuffer final
+{
+public:
+
+    DoubleBuffer() = default;
+
+    explicit DoubleBuffer(const TState& state)
+        : m_back(state)
+        , m_front(state)
+    {}
+
+    /// @brief State written by OnUpdate.
+    TState& Back() noexcept
+    {
+        return m_back;
+    }
+
+    /// @brief State read by OnDraw, as of the last Publish.
+    const TState& Front() const noexcept
+    {
+        return m_front;
+    }
+
+    /// @brief Makes the written state visible to drawing.
+    void Publish()
+    {
+        m_front = m_back;
+    }
+
+private:
+
+    TState m_back{};
+    TState m_front{};
+};
+
+} // namespace game_engine
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace game_engine
+{
+
+template <typename TSignature, std::size_t Capacity = 64>
+class InplaceFunction;
+
+/// @brief Move-only callable wrapper that stores the target inside the object and never allocates.
+/// Callables that don't fit into `Capacity` bytes are rejected at compile time.
+/// @tparam TResult    Return type of the call.
+/// @tparam TArgs      Argument types of the call.
+/// @tparam Capacity   Size of the in-place storage in bytes.
+template <typename TResult, typename... TArgs, std::size_t Capacity>
+class InplaceFunction<TResult(TArgs...), Capacity> final
+{
+public:
+
+    InplaceFunction() noexcept = default;
+
+    InplaceFunction(std::nullptr_t) noexcept
+    {}
+
+    template <typename TCallable>
+        requires(!std::is_same_v<std::remove_cvref_t<TCallable>, InplaceFunction> &&
+                 std::is_invocable_r_v<TResult, std::decay_t<TCallable>&, TArgs...>)
+    InplaceFunction(TCallable&& callable)
+    {
+        using TTarget = std::decay_t<TCallable>;
+
+        static_assert(sizeof(TTarget) <= Capacity, "Callable is too big for InplaceFunction, increase the capacity");
+        static_assert(alignof(TTarget) <= alignof(std::max_align_t), "Callable is over-aligned for InplaceFunction");
+        static_assert(std::is_nothrow_move_constructible_v<TTarget>, "Callable must be nothrow move constructible");
+
+        ::new (static_cast<void*>(&m_storage)) TTarget(std::forward<TCallable>(callable));
+        m_operations = &OperationsFor<TTarget>;
+    }
+
+    ~InplaceFunction()
+    {
+        Reset();
+    }
+
+    InplaceFunction(const InplaceFunction&) = delete;
+
+    InplaceFunction(InplaceFunction&& other) noexcept
+    {
+        MoveFrom(other);
+    }
+
+    InplaceFunction& operator=(const InplaceFunction&) = delete;
+
+    InplaceFunction& operator=(InplaceFunction&& other) noexcept
+    {
+        if (this != &other) {
+            Reset();
+            MoveFrom(other);
+        }
+        return *this;
+    }
+
+    InplaceFunction& operator=(std::nullptr_t) noexcept
+    {
+        Reset();
+        return *this;
+    }
+
+    /// @brief Invokes the stored callable. Calling an empty function throws std::bad_function_call.
+    TResult operator()(TArgs... args) const
+    {
+        if (m_operations == nullptr) {
+            throw std::bad_function_call();
+        }
+
+        return m_operations->invoke(&m_storage, std::forward<TArgs>(args)...);
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return m_operations != nullptr;
+    }
+
+    /// @brief Destroys the stored callable, leaving the function empty.
+    void Reset() noexcept
+    {
+        if (m_operations != nullptr) {
+            m_operations->destroy(&m_storage);
+            m_operations = nullptr;
+        }
+    }
+
+private:
+
+    struct Operations
+    {
+        TResult (*invoke)(void* storage, TArgs&&... args);
+        void (*move)(void* destination, void* source) noexcept;
+        void (*destroy)(void* storage) noexcept;
+    };
+
+    template <typename TTarget>
+    static constexpr Operations OperationsFor = {
+        [](void* storage, TArgs&&... args) -> TResult {
+            return std::invoke(*static_cast<TTarget*>(storage), std::forward<TArgs>(args)...);
+        },
+        [](void* destination, void* source) noexcept {
+            ::new (destination) TTarget(std::move(*static_cast<TTarget*>(source)));
+            static_cast<TTarget*>(source)->~TTarget();
+        },
+        [](void* storage) noexcept { static_cast<TTarget*>(storage)->~TTarget(); },
+    };
+
+    void MoveFrom(InplaceFunction& other) noexcept
+    {
+        if (other.m_operations != nullptr) {
+            other.m_operations->move(&m_storage, &other.m_storage);
+            m_operations       = other.m_operations;
+            other.m_operations = nullptr;
+        }
+    }
+
+    alignas(std::max_align_t) mutable std::byte m_storage[Capacity];
+    const Operations* m_operations = nullptr;
+};
+
+} // namespace game_engine
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <ostream>
+#include <string_view>
+
+/// @brief Scoped profiler zones, exported as Chrome trace JSON (chrome://tracing, ui.perfetto.dev).
+///
+/// Zones are enabled by the ENABLE_PROFILER CMake option, which defines ENABLE_PROFILER_ZONES.
+/// Without it PROFILE_ZONE expands to nothing, so instrumented code has no overhead.
+///
+/// Every thread writes its zones to its own buffer without locking. Timestamps come from the same
+/// steady clock as IEngine::GetTime, so they can be compared with engine time points.
+
+namespace game_engine::profiler
+{
+
+#ifdef ENABLE_PROFILER_ZONES
+inline constexpr bool Enabled = true;
+#else
+inline constexpr bool Enabled = false;
+#endif
+
+using Clock = std::chrono::steady_clock;
+
+/// @brief Records the time from construction to destruction as a zone of the current thread.
+/// Use the PROFILE_ZONE macro instead of creating it directly.
+class ScopedZone final
+{
+public:
+
+    /// @param name    Zone name, must outlive the profiler, e.g. a string literal.
+    explicit ScopedZone(const char* name) noexcept;
+    ~ScopedZone();
+
+    ScopedZone(const ScopedZone&) = delete;
+    ScopedZone(ScopedZone&&)      = delete;
+
+    ScopedZone& operator=(const ScopedZone&) = delete;
+    ScopedZone& operator=(ScopedZone&&)      = delete;
+
+private:
+
+    const char* m_name;
+    Clock::time_point m_start;
+};
+
+/// @brief Names the current thread in the trace.
+void SetThreadName(std::string_view name);
+
+/// @brief Writes all zones recorded so far. Safe to call while other threads record zones,
+/// zones that end during the call may be left out.
+void WriteChromeTrace(std::ostream& stream);
+
+/// @return False if the file can't be written.
+bool WriteChromeTrace(const std::filesystem::path& file);
+
+/// @brief Returns the number of zones dropped because a thread buffer was full.
+std::size_t GetDroppedZonesCount();
+
+} // namespace game_engine::profiler
+
+#define PROFILER_CONCAT_IMPL(a, b) a##b
+#define PROFILER_CONCAT(a, b)      PROFILER_CONCAT_IMPL(a, b)
+
+#ifdef ENABLE_PROFILER_ZONES
+    #define PROFILE_ZONE(name)     const ::game_engine::profiler::ScopedZone PROFILER_CONCAT(profile_zone_, __LINE__)(name)
+    #define PROFILE_THREAD(name)   ::game_engine::profiler::SetThreadName(name)
+#else
+    #define PROFILE_ZONE(name)
+    #define PROFILE_THREAD(name)
+#endif
@@ -1,5 +1,10 @@
 #include "stub_backend.hpp"
 
+#include <fstream>
+
+#define LOG_ERROR std::cerr
+#include <iostream>
+
 namespace game_engine::backend
 {
 
@@ -29,12 +34,38 @@ void StubBackend::DetachBackendObserver(const IBackendObserver& observer)
 
 void StubBackend::PollEvents() const
 {
+    if (m_replay) {
+        ReplayFrame();
+        m_frames_count++;
+        return;
+    }
+
     m_frames_count++;
     if (m_frames_count >= m_target_frames_count) {
-        for (auto observer : m_observers) {
-            observer.get().OnEvent(WindowCloseEvent{});
-        }
+        Notify(WindowCloseEvent{});
+    }
+}
+
+bool StubBackend::ReplayEvents(const std::filesystem::path& file)
+{
+    std::ifstream stream(file, std::ios::binary);
+    if (!stream || !ReadEventRecordHeader(stream)) {
+        LOG_ERROR << "Failed to read event recording: " << file << std::endl;
+        return false;
+    }
+
+    std::vector<EventRecord> records;
+    EventRecord record;
+    while (ReadEventRecord(stream, record)) {
+        records.push_back(record);
     }
+
+    m_replay_records  = std::move(records);
+    m_replay_position = 0;
+    m_frames_count    = 0;
+    m_replay          = true;
+
+    return true;
 }
 
 void StubBackend::MakeContextCurrent() const
@@ -46,4 +77,33 @@ void StubBackend::DropCurrentContext() const
 void StubBackend::SwapBuffers() const
 {}
 
+#pragma endregion
+
+#pragma region Private helpers
+
+template <typename TEventType>
+void StubBackend::Notify(const TEventType& event) const
+{
+    for (auto observer : m_observers) {
+        observer.get().OnEvent(event);
+    }
+}
+
+void StubBackend::ReplayFrame() const
+{
+    const auto frame = static_cast<std::uint32_t>(m_frames_count);
+
+    while (m_replay_position < m_replay_records.size() && m_replay_records[m_replay_position].frame <= frame) {
+        VisitEventRecord(m_replay_records[m_replay_position++], [this](const auto& event) { Notify(event); });
+    }
+
+    // The recording is over, close one frame after its last events
+    const bool finished = m_replay_position == m_replay_records.size();
+    if (finished && (m_replay_records.empty() || m_replay_records.back().frame < frame)) {
+        Notify(WindowCloseEvent{});
+    }
+}
+
+#pragma endregion
+
 } // namespace game_engine::backend
@@ -1,10 +1,15 @@
 #pragma once
 
+#include <vector>
+
 #include <modules/backend/backend_module.hpp>
+#include <modules/backend/event_record.hpp>
 
 namespace game_engine::backend
 {
 
+/// @brief Backend without a window. Closes after a fixed number of frames, or replays a recording
+/// and closes once all recorded events are delivered.
 class StubBackend final : public IBackendModule
 {
 public:
@@ -20,6 +25,7 @@ public:
     void DetachBackendObserver(const IBackendObserver& observer) override;
 
     void PollEvents() const override;
+    bool ReplayEvents(const std::filesystem::path& file) override;
 
     void MakeContextCurrent() const override;
     void DropCurrentContext() const override;
@@ -27,9 +33,18 @@ public:
 
 private:
 
+    template <typename TEventType>
+    void Notify(const TEventType& event) const;
+
+    void ReplayFrame() const;
+
     mutable int m_frames_count = 0;
     int m_target_frames_count  = 100;
 
+    std::vector<EventRecord> m_replay_records;
+    mutable std::size_t m_replay_position = 0;
+    bool m_replay                         = false;
+
     std::list<RefObserver> m_observers;
 };
 
@@ -130,7 +130,7 @@ bool OpenGLMesh::Load(const std::shared_ptr<IMesh>& mesh)
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
         glBufferData(GL_ELEMENT_ARRAY_BUFFER, index_data_size, nullptr, GL_STATIC_DRAW);
 
-        m_submeshes.clear();
+        m_batches.clear();
 
         GLintptr current_offset = 0;
         for (const auto& submesh : mesh->GetSubMeshes()) {
@@ -139,8 +139,13 @@ bool OpenGLMesh::Load(const std::shared_ptr<IMesh>& mesh)
                 const GLenum index_type = GetIndicesType(submesh.indices);
 
                 glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, current_offset, size, submesh.indices.data());
-                m_submeshes.push_back(
-                    {.count = static_cast<GLsizei>(submesh.indices.size()), .offset = current_offset, .type = index_type});
+
+                if (m_batches.empty() || m_batches.back().type != index_type) {
+                    m_batches.push_back({.type = index_type, .counts = {}, .offsets = {}});
+                }
+
+                m_batches.back().counts.push_back(static_cast<GLsizei>(submesh.indices.size()));
+                m_batches.back().offsets.push_back(reinterpret_cast<const void*>(current_offset));
                 current_offset += size;
             }
         }
@@ -209,7 +214,7 @@ void OpenGLMesh::Clear() noexcept
         glDeleteBuffers(1, &m_ebo);
     }
 
-    m_submeshes.clear();
+    m_batches.clear();
 
     m_vertex_count   = 0;
     m_primitive_type = 0;
@@ -219,27 +224,69 @@ void OpenGLMesh::Clear() noexcept
     m_ebo = 0;
 }
 
-void OpenGLMesh::Render() const
+GLuint OpenGLMesh::GetVertexArray() const noexcept
 {
-    glBindVertexArray(m_vao);
+    return m_vao;
+}
 
-    if (!m_submeshes.empty()) {
-        for (const auto& submesh : m_submeshes) {
-            glDrawElements(m_primitive_type, submesh.count, submesh.type, reinterpret_cast<void*>(submesh.offset));
-        }
-    } else {
+std::uint32_t OpenGLMesh::Render() const
+{
+    if (m_batches.empty()) {
         glDrawArrays(m_primitive_type, 0, m_vertex_count);
+        return 1;
     }
+
+    for (const auto& batch : m_batches) {
+        if (batch.counts.size() == 1) {
+            glDrawElements(m_primitive_type, batch.counts[0], batch.type, batch.offsets[0]);
+        } else {
+            glMultiDrawElements(m_primitive_type,
+                batch.counts.data(),
+                batch.type,
+                batch.offsets.data(),
+                static_cast<GLsizei>(batch.counts.size()));
+        }
+    }
+
+    return static_cast<std::uint32_t>(m_batches.size());
 }
 
-void OpenGLMesh::RenderInstanced(GLsizei instance_count) const
+std::uint32_t OpenGLMesh::RenderInstanced(GLsizei instance_count) const
 {
-    if (!m_submeshes.empty()) {
-        for (const auto& submesh : m_submeshes) {
-            glDrawElementsInstanced(m_primitive_type, submesh.count, submesh.type, reinterpret_cast<void*>(submesh.offset), instance_count);
-        }
-    } else {
+    if (m_batches.empty()) {
         glDrawArraysInstanced(m_primitive_type, 0, m_vertex_count, instance_count);
+        return 1;
+    }
+
+    std::uint32_t draw_calls = 0;
+    for (const auto& batch : m_batches) {
+        for (std::size_t i = 0; i < batch.counts.size(); ++i) {
+            glDrawElementsInstanced(m_primitive_type, batch.counts[i], batch.type, batch.offsets[i], instance_count);
+        }
+        draw_calls += static_cast<std::uint32_t>(batch.counts.size());
+    }
+
+    return draw_calls;
+}
+
+void OpenGLMesh::BindInstanceTransforms(GLuint location, GLintptr offset) const
+{
+    constexpr GLsizei stride = sizeof(Matrix4);
+
+    // A mat4 attribute is four vec4 columns
+    for (GLuint column = 0; column < 4; ++column) {
+        const GLintptr column_offset = offset + static_cast<GLintptr>(column * sizeof(Vector4));
+
+        glVertexAttribPointer(location + column, 4, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(column_offset));
+        glVertexAttribDivisor(location + column, 1);
+        glEnableVertexAttribArray(location + column);
+    }
+}
+
+void OpenGLMesh::UnbindInstanceTransforms(GLuint location) const
+{
+    for (GLuint column = 0; column < 4; ++column) {
+        glDisableVertexAttribArray(location + column);
     }
 }
 
@@ -247,7 +294,7 @@ void swap(OpenGLMesh& a, OpenGLMesh& b) noexcept
 {
     using std::swap;
 
-    swap(a.m_submeshes, b.m_submeshes);
+    swap(a.m_batches, b.m_batches);
     swap(a.m_vertex_count, b.m_vertex_count);
     swap(a.m_primitive_type, b.m_primitive_type);
     swap(a.m_vao, b.m_vao);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 
 #include <engine/graphics/mesh.hpp>
@@ -26,21 +27,39 @@ public:
     bool IsValid() const noexcept;
     void Clear() noexcept;
 
-    void Render() const;
-    void RenderInstanced(GLsizei instance_count) const;
+    /// @brief Returns the vertex array, it has to be bound before the calls below.
+    GLuint GetVertexArray() const noexcept;
+
+    /// @brief Draws all submeshes, those sharing an index type in one glMultiDrawElements call.
+    /// @return Number of draw calls issued.
+    std::uint32_t Render() const;
+
+    /// @brief Draws the submeshes one by one, OpenGL 3.3 has no instanced multi-draw.
+    /// @return Number of draw calls issued.
+    std::uint32_t RenderInstanced(GLsizei instance_count) const;
+
+    /// @brief Feeds a mat4 attribute from the per-instance transforms of the buffer bound to GL_ARRAY_BUFFER.
+    /// @param location    Location of the attribute, it takes four locations from there on.
+    /// @param offset      Offset of the first instance's transform in the buffer of tightly packed Matrix4, in bytes.
+    void BindInstanceTransforms(GLuint location, GLintptr offset) const;
+
+    /// @brief Disables the attribute arrays set by BindInstanceTransforms, so draws that aren't instanced read the
+    /// attribute's constant value instead of another draw's transforms.
+    void UnbindInstanceTransforms(GLuint location) const;
 
 private:
 
-    struct SubMesh
+    /// @brief Consecutive submeshes with the same index type, the arguments of one glMultiDrawElements call.
+    struct DrawBatch
     {
-        GLsizei count;
-        GLintptr offset;
         GLenum type;
+        std::vector<GLsizei> counts;
+        std::vector<const void*> offsets; ///< Offsets in the index buffer.
     };
 
     friend void swap(OpenGLMesh& a, OpenGLMesh& b) noexcept;
 
-    std::vector<SubMesh> m_submeshes;
+    std::vector<DrawBatch> m_batches;
 
     GLint m_vertex_count    = 0;
     GLenum m_primitive_type = 0;
@@ -1,9 +1,26 @@
 #include "opengl_renderer.hpp"
 
 #include <glad/glad.h>
-#include <opengl_mesh.hpp>
-#include <opengl_shader.hpp>
-#include <opengl_texture.hpp>
+#include <opengl_utils.hpp>
+
+namespace
+{
+
+#if defined(ENABLE_OPENGL_DEBUG_CHECKS)
+constexpr bool CheckEveryDraw = true;
+#else
+constexpr bool CheckEveryDraw = false;
+#endif
+
+/// @brief Polls glGetError after a draw, only in builds with ENABLE_OPENGL_DEBUG.
+void CheckDrawErrors()
+{
+    if constexpr (CheckEveryDraw) {
+        game_engine::graphics::HasOpenGLErrors();
+    }
+}
+
+} // namespace
 
 namespace game_engine::graphics
 {
@@ -30,68 +47,84 @@ bool OpenGLRenderer::Init()
     glFrontFace(GL_CCW);
     glCullFace(GL_BACK);
 
+    m_state.Invalidate();
+
+    glGenBuffers(1, &m_instance_buffer);
+
     return true;
 }
 
 void OpenGLRenderer::Shutdown() noexcept
 {
     UnloadAll();
+
+    if (m_instance_buffer != 0) {
+        glDeleteBuffers(1, &m_instance_buffer);
+        m_instance_buffer = 0;
+    }
 }
 
-bool OpenGLRenderer::Load(const std::shared_ptr<IMesh>& mesh)
+RenderHandle OpenGLRenderer::Load(const std::shared_ptr<IMesh>& mesh)
 {
-    if (m_meshes.contains(mesh->GetId())) {
-        return false;
-    }
+    // Loading binds objects of its own
+    m_state.Invalidate();
 
     OpenGLMesh opengl_mesh;
     if (!opengl_mesh.Load(mesh)) {
         throw std::runtime_error("Mesh loading failed");
     }
 
-    const auto [_, inserted] = m_meshes.emplace(mesh->GetId(), std::move(opengl_mesh));
+    const RenderHandle handle = m_meshes.Insert(std::move(opengl_mesh));
+    if (!handle.IsValid()) {
+        throw std::runtime_error("Too many meshes");
+    }
 
-    return inserted;
+    return handle;
 }
 
-bool OpenGLRenderer::Load(const std::shared_ptr<IShader>& shader)
+RenderHandle OpenGLRenderer::Load(const std::shared_ptr<IShader>& shader)
 {
-    if (m_shaders.contains(shader->GetId())) {
-        return false;
-    }
+    m_state.Invalidate();
 
     OpenGLShader opengl_shader;
     if (!opengl_shader.Load(shader)) {
         throw std::runtime_error("Shader loading failed");
     }
 
-    const auto [_, inserted] = m_shaders.emplace(shader->GetId(), std::move(opengl_shader));
+    const RenderHandle handle = m_shaders.Insert(std::move(opengl_shader));
+    if (!handle.IsValid()) {
+        throw std::runtime_error("Too many shaders");
+    }
 
-    return inserted;
+    return handle;
 }
 
-bool OpenGLRenderer::Load(const std::shared_ptr<ITexture>& texture)
+RenderHandle OpenGLRenderer::Load(const std::shared_ptr<ITexture>& texture)
 {
-    if (m_textures.contains(texture->GetId())) {
-        return false;
-    }
+    m_state.Invalidate();
 
     OpenGLTexture opengl_texture;
     if (!opengl_texture.Load(texture)) {
         throw std::runtime_error("Texture loading failed");
     }
 
-    const auto& [_, inserted] = m_textures.emplace(texture->GetId(), std::move(opengl_texture));
+    const RenderHandle handle = m_textures.Insert(std::move(opengl_texture));
+    if (!handle.IsValid()) {
+        throw std::runtime_error("Too many textures");
+    }
 
-    return inserted;
+    return handle;
 }
 
-void OpenGLRenderer::Unload(ResourceType type, ResourceId id)
+void OpenGLRenderer::Unload(ResourceType type, RenderHandle handle)
 {
+    // Deleting a bound object resets its binding
+    m_state.Invalidate();
+
     switch (type) {
-        case ResourceType::Mesh:    m_meshes.erase(id); break;
-        case ResourceType::Shader:  m_shaders.erase(id); break;
-        case ResourceType::Texture: m_textures.erase(id); break;
+        case ResourceType::Mesh:    m_meshes.Erase(handle); break;
+        case ResourceType::Shader:  m_shaders.Erase(handle); break;
+        case ResourceType::Texture: m_textures.Erase(handle); break;
 
         default: break;
     }
@@ -99,59 +132,161 @@ void OpenGLRenderer::Unload(ResourceType type, ResourceId id)
 
 void OpenGLRenderer::UnloadAll()
 {
-    m_meshes.clear();
-    m_shaders.clear();
-    m_textures.clear();
+    m_state.Invalidate();
+
+    m_meshes.Clear();
+    m_shaders.Clear();
+    m_textures.Clear();
 }
 
 void OpenGLRenderer::Execute(const BeginFrameCommand& command)
 {
     glClearColor(0.3f, 0.3f, 0.2f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    m_properties          = command.properties;
+    m_instance_transforms = command.instance_transforms;
+    m_draw_calls          = 0;
+    m_state.ResetStats();
+
+    if (!m_instance_transforms.empty()) {
+        // Orphan the last frame's data, the driver may still be reading it
+        const auto size = static_cast<GLsizeiptr>(m_instance_transforms.size_bytes());
+
+        m_state.BindArrayBuffer(m_instance_buffer);
+        glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, size, m_instance_transforms.data());
+    }
 }
 
 void OpenGLRenderer::Execute(const EndFrameCommand& command)
 {
     // TODO: Implement textures handling
     // m_next_texture_unit = 0; // Reset textures counter
+
+    m_properties          = nullptr;
+    m_instance_transforms = {};
+    m_frame_draw_calls    = m_draw_calls;
+    m_frame_state_changes = m_state.GetStats();
+
+    // Errors of the frame's draws, once per frame unless every draw is checked
+    if constexpr (!CheckEveryDraw) {
+        HasOpenGLErrors();
+    }
 }
 
 void OpenGLRenderer::Execute(const RenderCommand& command)
 {
-    const auto shader_it = m_shaders.find(command.shader);
-    if (shader_it == m_shaders.end()) {
+    const OpenGLShader* shader_ptr = m_shaders.Get(command.shader);
+    if (shader_ptr == nullptr) {
         throw std::runtime_error("Shader not found");
     }
 
-    const auto& shader = shader_it->second;
+    const auto& shader = *shader_ptr;
 
     if (!shader.IsValid()) {
         throw std::runtime_error("Shader not valid");
     }
 
-    const auto mesh_it = m_meshes.find(command.mesh);
-    if (mesh_it == m_meshes.end()) {
+    const OpenGLMesh* mesh_ptr = m_meshes.Get(command.mesh);
+    if (mesh_ptr == nullptr) {
         throw std::runtime_error("Mesh not found");
     }
 
-    const auto& mesh = mesh_it->second;
+    const auto& mesh = *mesh_ptr;
 
     if (!mesh.IsValid()) {
         throw std::runtime_error("Mesh not valid");
     }
 
-    shader.Use();
+    m_state.UseProgram(shader.GetProgram());
+    m_state.BindVertexArray(mesh.GetVertexArray());
+
+    if (command.properties.count != 0) {
+        if (m_properties == nullptr) {
+            throw std::runtime_error("Properties not provided");
+        }
+
+        for (const auto& property : m_properties->Get(command.properties)) {
+            shader.SetProperty(*m_properties, property);
+        }
+    }
+
+    const GLint location = shader.GetInstanceTransformLocation();
+
+    if (command.instance_count <= 1) {
+        if (location >= 0) {
+            shader.SetInstanceTransformAttribute(FindInstanceTransform(command));
+        }
+
+        m_draw_calls += mesh.Render();
+        CheckDrawErrors();
+        return;
+    }
+
+    if (std::size_t{command.first_instance} + command.instance_count > m_instance_transforms.size()) {
+        throw std::runtime_error("Instance transforms out of range");
+    }
+
+    if (location >= 0) {
+        m_state.BindArrayBuffer(m_instance_buffer);
+        mesh.BindInstanceTransforms(static_cast<GLuint>(location), static_cast<GLintptr>(command.first_instance * sizeof(Matrix4)));
+        m_draw_calls += mesh.RenderInstanced(static_cast<GLsizei>(command.instance_count));
+        mesh.UnbindInstanceTransforms(static_cast<GLuint>(location));
+        CheckDrawErrors();
+        return;
+    }
+
+    // The shader only has the transform uniform, draw the instances one by one
+    for (const auto& transform : m_instance_transforms.subspan(command.first_instance, command.instance_count)) {
+        shader.SetInstanceTransform(transform);
+        m_draw_calls += mesh.Render();
+    }
+
+    CheckDrawErrors();
+}
+
+std::optional<std::vector<ShaderProperty>> OpenGLRenderer::GetShaderProperties(RenderHandle shader) const
+{
+    const OpenGLShader* shader_ptr = m_shaders.Get(shader);
+    if (shader_ptr == nullptr) {
+        throw std::runtime_error("Shader not found");
+    }
+
+    return shader_ptr->GetProperties();
+}
 
-    for (const auto& property : command.properties) {
-        shader.SetProperty(property);
-        // TODO: move uniform setup here
+void OpenGLRenderer::ResolveShaderProperties(RenderHandle shader, std::span<const ShaderProperty> properties)
+{
+    OpenGLShader* shader_ptr = m_shaders.Get(shader);
+    if (shader_ptr == nullptr) {
+        throw std::runtime_error("Shader not found");
     }
 
-    if (command.instance_count > 1) {
-        mesh.RenderInstanced(command.instance_count);
-    } else {
-        mesh.Render();
+    shader_ptr->ResolveProperties(properties);
+}
+
+Matrix4 OpenGLRenderer::FindInstanceTransform(const RenderCommand& command) const
+{
+    if (m_properties != nullptr) {
+        for (const auto& property : m_properties->Get(command.properties)) {
+            if (property.type == PropertyType::Matrix4 && property.id.GetName() == InstanceTransformProperty) {
+                return m_properties->GetValue<Matrix4>(property);
+            }
+        }
     }
+
+    return Matrix4(1.0f);
+}
+
+std::uint32_t OpenGLRenderer::GetDrawCallsCount() const noexcept
+{
+    return m_frame_draw_calls;
+}
+
+StateChangeStats OpenGLRenderer::GetStateChanges() const noexcept
+{
+    return m_frame_state_changes;
 }
 
 #pragma endregion
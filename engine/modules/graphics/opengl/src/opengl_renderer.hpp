@@ -1,17 +1,19 @@
 #pragma once
 
-#include <unordered_map>
+#include <cstdint>
+#include <span>
 #include <vector>
 
 #include <modules/graphics/renderer_module.hpp>
 
+#include <opengl_mesh.hpp>
+#include <opengl_shader.hpp>
+#include <opengl_state.hpp>
+#include <opengl_texture.hpp>
+
 namespace game_engine::graphics
 {
 
-class OpenGLMesh;
-class OpenGLShader;
-class OpenGLTexture;
-
 class OpenGLRenderer final : public IRendererModule
 {
 public:
@@ -29,22 +31,42 @@ public:
     bool Init() override;
     void Shutdown() noexcept override;
 
-    bool Load(const std::shared_ptr<IMesh>& mesh) override;
-    bool Load(const std::shared_ptr<IShader>& shader) override;
-    bool Load(const std::shared_ptr<ITexture>& texture) override;
+    RenderHandle Load(const std::shared_ptr<IMesh>& mesh) override;
+    RenderHandle Load(const std::shared_ptr<IShader>& shader) override;
+    RenderHandle Load(const std::shared_ptr<ITexture>& texture) override;
 
-    void Unload(ResourceType type, ResourceId id) override;
+    void Unload(ResourceType type, RenderHandle handle) override;
     void UnloadAll() override;
 
     void Execute(const BeginFrameCommand& command) override;
     void Execute(const EndFrameCommand& command) override;
     void Execute(const RenderCommand& command) override;
 
+    std::optional<std::vector<ShaderProperty>> GetShaderProperties(RenderHandle shader) const override;
+    void ResolveShaderProperties(RenderHandle shader, std::span<const ShaderProperty> properties) override;
+
+    std::uint32_t GetDrawCallsCount() const noexcept override;
+    StateChangeStats GetStateChanges() const noexcept override;
+
 private:
 
-    std::unordered_map<ResourceId, OpenGLMesh> m_meshes;
-    std::unordered_map<ResourceId, OpenGLShader> m_shaders;
-    std::unordered_map<ResourceId, OpenGLTexture> m_textures;
+    /// @brief Returns the command's InstanceTransformProperty, the identity if it has none.
+    Matrix4 FindInstanceTransform(const RenderCommand& command) const;
+
+    HandleTable<OpenGLMesh> m_meshes;
+    HandleTable<OpenGLShader> m_shaders;
+    HandleTable<OpenGLTexture> m_textures;
+
+    OpenGLState m_state;
+
+    const PropertyBuffer* m_properties = nullptr; ///< Properties of the current frame.
+
+    unsigned int m_instance_buffer = 0; ///< Transforms of the current frame's instanced draws.
+    std::span<const Matrix4> m_instance_transforms;
+
+    std::uint32_t m_draw_calls       = 0; ///< Draw calls of the current frame.
+    std::uint32_t m_frame_draw_calls = 0; ///< Draw calls of the last finished frame.
+    StateChangeStats m_frame_state_changes;
 };
 
 } // namespace game_engine::graphics
@@ -1,14 +1,13 @@
 #include "opengl_shader.hpp"
 
+#include <algorithm>
 #include <sstream>
 #include <stdexcept>
 
 #include <glad/glad.h>
+#include <modules/graphics/render_command.hpp>
 #include <opengl_utils.hpp>
 
-#define LOG_ERROR std::cerr
-#include <iostream>
-
 namespace
 {
 std::string ShaderTypeString(int shader_type)
@@ -101,6 +100,44 @@ bool CompileShaderProgram(GLuint program_id, GLuint vertex_shader_id, GLuint fra
     return true;
 }
 
+bool IsSamplerType(GLenum type)
+{
+    switch (type) {
+        case GL_SAMPLER_1D:
+        case GL_SAMPLER_2D:
+        case GL_SAMPLER_3D:
+        case GL_SAMPLER_CUBE:
+        case GL_SAMPLER_1D_SHADOW:
+        case GL_SAMPLER_2D_SHADOW:
+        case GL_SAMPLER_1D_ARRAY:
+        case GL_SAMPLER_2D_ARRAY:
+        case GL_SAMPLER_2D_MULTISAMPLE:
+        case GL_INT_SAMPLER_2D:
+        case GL_UNSIGNED_INT_SAMPLER_2D: return true;
+
+        default: return false;
+    }
+}
+
+/// @brief Checks that the glUniform call of the property type can set a uniform of the GL type.
+bool IsCompatible(game_engine::graphics::PropertyType property_type, GLenum uniform_type)
+{
+    using game_engine::graphics::PropertyType;
+
+    switch (property_type) {
+        case PropertyType::Int:     return uniform_type == GL_INT || uniform_type == GL_BOOL || IsSamplerType(uniform_type);
+        case PropertyType::Float:   return uniform_type == GL_FLOAT || uniform_type == GL_BOOL;
+        case PropertyType::Vector2: return uniform_type == GL_FLOAT_VEC2;
+        case PropertyType::Vector3: return uniform_type == GL_FLOAT_VEC3;
+        case PropertyType::Vector4: return uniform_type == GL_FLOAT_VEC4;
+        case PropertyType::Matrix3: return uniform_type == GL_FLOAT_MAT3;
+        case PropertyType::Matrix4: return uniform_type == GL_FLOAT_MAT4;
+        case PropertyType::Texture: return IsSamplerType(uniform_type);
+    }
+
+    return false;
+}
+
 } // namespace
 
 namespace game_engine::graphics
@@ -167,6 +204,13 @@ bool OpenGLShader::Load(const std::shared_ptr<IShader>& shader)
         return false;
     }
 
+    ReflectUniforms();
+
+    m_instance_transform_location = glGetAttribLocation(m_shader_program, InstanceTransformAttribute);
+    if (const auto* transform = FindUniform(InstanceTransformProperty); transform && transform->type == GL_FLOAT_MAT4) {
+        m_instance_transform_uniform = transform->location;
+    }
+
     return true;
 }
 
@@ -193,66 +237,216 @@ void OpenGLShader::Clear() noexcept
     m_fragment_shader = 0;
     m_shader_program  = 0;
 
-    m_uniform_cache.clear();
+    m_instance_transform_location = -1;
+    m_instance_transform_uniform  = -1;
+
+    m_uniforms.clear();
+    m_uniform_blocks.clear();
+    m_properties.clear();
 }
 
-void OpenGLShader::Use() const
+unsigned int OpenGLShader::GetProgram() const noexcept
 {
-    glUseProgram(m_shader_program);
-    HasOpenGLErrors();
+    return m_shader_program;
 }
 
-void OpenGLShader::SetProperty(const Property& property) const
+void OpenGLShader::SetProperty(const PropertyBuffer& buffer, const PackedProperty& property) const
 {
-    const GLint location = GetUniformLocation(property.name);
+    const GLint location = GetPropertyLocation(property);
 
     if (location < 0 || m_shader_program == 0) {
-        LOG_ERROR << "[SHADER] Uniform is negative or shader program is not initialized." << std::endl;
         return;
     }
 
-    std::visit([location](auto&& arg) {
-        using T = std::decay_t<decltype(arg)>;
-
-        if constexpr (std::is_same_v<T, int>) {
-            glUniform1i(location, arg);
-        } else if constexpr (std::is_same_v<T, float>) {
-            glUniform1f(location, arg);
-        } else if constexpr (std::is_same_v<T, Vector2>) {
-            glUniform2f(location, arg.x, arg.y);
-        } else if constexpr (std::is_same_v<T, Vector3>) {
-            glUniform3f(location, arg.x, arg.y, arg.z);
-        } else if constexpr (std::is_same_v<T, Vector4>) {
-            glUniform4f(location, arg.x, arg.y, arg.z, arg.w);
-        } else if constexpr (std::is_same_v<T, Matrix3>) {
-            glUniformMatrix3fv(location, 1, GL_FALSE, &arg[0][0]);
-        } else if constexpr (std::is_same_v<T, Matrix4>) {
-            glUniformMatrix4fv(location, 1, GL_FALSE, &arg[0][0]);
-        } else if constexpr (std::is_same_v<T, std::shared_ptr<ITexture>>) {
+    switch (property.type) {
+        case PropertyType::Int:   glUniform1i(location, buffer.GetValue<int>(property)); break;
+        case PropertyType::Float: glUniform1f(location, buffer.GetValue<float>(property)); break;
+        case PropertyType::Vector2: {
+            const auto value = buffer.GetValue<Vector2>(property);
+            glUniform2f(location, value.x, value.y);
+        } break;
+        case PropertyType::Vector3: {
+            const auto value = buffer.GetValue<Vector3>(property);
+            glUniform3f(location, value.x, value.y, value.z);
+        } break;
+        case PropertyType::Vector4: {
+            const auto value = buffer.GetValue<Vector4>(property);
+            glUniform4f(location, value.x, value.y, value.z, value.w);
+        } break;
+        case PropertyType::Matrix3: {
+            const auto value = buffer.GetValue<Matrix3>(property);
+            glUniformMatrix3fv(location, 1, GL_FALSE, &value[0][0]);
+        } break;
+        case PropertyType::Matrix4: {
+            const auto value = buffer.GetValue<Matrix4>(property);
+            glUniformMatrix4fv(location, 1, GL_FALSE, &value[0][0]);
+        } break;
+        case PropertyType::Texture:
             //glActiveTexture(GL_TEXTURE0 + m_next_texture_unit);
             // TODO: bind texture;
             //glUniform1i(location, m_next_texture_unit++);
-        } else {
-            static_assert(!std::is_same_v<T, T>, "Unsupported uniform type");
+            break;
+    }
+}
+
+void OpenGLShader::SetInstanceTransform(const Matrix4& transform) const
+{
+    if (m_instance_transform_uniform >= 0) {
+        glUniformMatrix4fv(m_instance_transform_uniform, 1, GL_FALSE, &transform[0][0]);
+    }
+}
+
+void OpenGLShader::SetInstanceTransformAttribute(const Matrix4& transform) const
+{
+    if (m_instance_transform_location < 0) {
+        return;
+    }
+
+    // A mat4 attribute is four vec4 columns
+    for (GLuint column = 0; column < 4; ++column) {
+        glVertexAttrib4fv(static_cast<GLuint>(m_instance_transform_location) + column, &transform[column][0]);
+    }
+}
+
+int OpenGLShader::GetInstanceTransformLocation() const noexcept
+{
+    return m_instance_transform_location;
+}
+
+std::vector<ShaderProperty> OpenGLShader::GetProperties() const
+{
+    constexpr PropertyType Types[] = {
+        PropertyType::Int,
+        PropertyType::Float,
+        PropertyType::Vector2,
+        PropertyType::Vector3,
+        PropertyType::Vector4,
+        PropertyType::Matrix3,
+        PropertyType::Matrix4,
+        PropertyType::Texture,
+    };
+
+    std::vector<ShaderProperty> properties;
+    for (const auto& uniform : m_uniforms) {
+        if (uniform.location < 0) {
+            continue;
+        }
+
+        std::uint32_t accepted_types = 0;
+        for (const auto type : Types) {
+            if (IsCompatible(type, uniform.type)) {
+                accepted_types |= GetPropertyTypeBit(type);
+            }
         }
-    }, property.value);
+
+        if (accepted_types != 0) {
+            properties.push_back({.name = uniform.name, .accepted_types = accepted_types, .id = {}});
+        }
+    }
+
+    return properties;
+}
+
+void OpenGLShader::ResolveProperties(std::span<const ShaderProperty> properties)
+{
+    for (const auto& property : properties) {
+        const auto* uniform = FindUniform(property.name);
+        if (uniform == nullptr || uniform->location < 0) {
+            continue;
+        }
+
+        const std::size_t index = property.id.GetIndex();
+        if (index >= m_properties.size()) {
+            m_properties.resize(index + 1);
+        }
+
+        m_properties[index] = {.location = uniform->location, .accepted_types = property.accepted_types};
+    }
+}
+
+std::span<const OpenGLShader::UniformInfo> OpenGLShader::GetUniforms() const noexcept
+{
+    return m_uniforms;
+}
+
+std::span<const OpenGLShader::UniformBlockInfo> OpenGLShader::GetUniformBlocks() const noexcept
+{
+    return m_uniform_blocks;
 }
 
-int OpenGLShader::GetUniformLocation(const std::string& name) const
+const OpenGLShader::UniformInfo* OpenGLShader::FindUniform(std::string_view name) const noexcept
 {
-    if (m_uniform_cache.find(name) != m_uniform_cache.end()) {
-        return m_uniform_cache[name];
+    const auto it = std::ranges::lower_bound(m_uniforms, name, {}, &UniformInfo::name);
+    return it != m_uniforms.end() && it->name == name ? &*it : nullptr;
+}
+
+void OpenGLShader::ReflectUniforms()
+{
+    m_uniforms.clear();
+    m_uniform_blocks.clear();
+    m_properties.clear();
+
+    GLint uniforms_count  = 0;
+    GLint max_name_length = 0;
+    glGetProgramiv(m_shader_program, GL_ACTIVE_UNIFORMS, &uniforms_count);
+    glGetProgramiv(m_shader_program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_name_length);
+
+    std::string name(static_cast<std::size_t>(std::max(max_name_length, 1)), '\0');
+    for (GLint i = 0; i < uniforms_count; ++i) {
+        GLsizei length = 0;
+        GLint size     = 0;
+        GLenum type    = 0;
+        glGetActiveUniform(m_shader_program, static_cast<GLuint>(i), static_cast<GLsizei>(name.size()), &length, &size, &type, name.data());
+
+        UniformInfo uniform{
+            .name     = name.substr(0, static_cast<std::size_t>(length)),
+            .type     = type,
+            .size     = size,
+            .location = glGetUniformLocation(m_shader_program, name.c_str()),
+        };
+
+        // Arrays are reported by their first element
+        if (uniform.name.ends_with("[0]")) {
+            uniform.name.resize(uniform.name.size() - 3);
+        }
+
+        m_uniforms.push_back(std::move(uniform));
     }
 
-    int location = glGetUniformLocation(m_shader_program, name.c_str());
-    if (location == -1) {
-        LOG_ERROR << "[SHADER] Uniform '" << name << "' not found." << std::endl;
-        HasOpenGLErrors();
-        return location;
+    GLint blocks_count = 0;
+    glGetProgramiv(m_shader_program, GL_ACTIVE_UNIFORM_BLOCKS, &blocks_count);
+    glGetProgramiv(m_shader_program, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &max_name_length);
+
+    name.assign(static_cast<std::size_t>(std::max(max_name_length, 1)), '\0');
+    for (GLint i = 0; i < blocks_count; ++i) {
+        const auto index = static_cast<GLuint>(i);
+
+        GLsizei length = 0;
+        glGetActiveUniformBlockName(m_shader_program, index, static_cast<GLsizei>(name.size()), &length, name.data());
+
+        UniformBlockInfo block{.name = name.substr(0, static_cast<std::size_t>(length)), .index = index};
+        glGetActiveUniformBlockiv(m_shader_program, index, GL_UNIFORM_BLOCK_DATA_SIZE, &block.data_size);
+        glGetActiveUniformBlockiv(m_shader_program, index, GL_UNIFORM_BLOCK_BINDING, &block.binding);
+
+        m_uniform_blocks.push_back(std::move(block));
+    }
+
+    std::ranges::sort(m_uniforms, {}, &UniformInfo::name);
+    std::ranges::sort(m_uniform_blocks, {}, &UniformBlockInfo::name);
+
+    HasOpenGLErrors();
+}
+
+int OpenGLShader::GetPropertyLocation(const PackedProperty& property) const noexcept
+{
+    const std::size_t index = property.id.GetIndex();
+    if (index >= m_properties.size()) {
+        return -1;
     }
 
-    m_uniform_cache[name] = location;
-    return location;
+    // Mismatches are reported by the engine when the draw is recorded
+    const auto& resolved = m_properties[index];
+    return (resolved.accepted_types & GetPropertyTypeBit(property.type)) != 0 ? resolved.location : -1;
 }
 
 void swap(OpenGLShader& a, OpenGLShader& b) noexcept
@@ -262,7 +456,11 @@ void swap(OpenGLShader& a, OpenGLShader& b) noexcept
     swap(a.m_shader_program, b.m_shader_program);
     swap(a.m_vertex_shader, b.m_vertex_shader);
     swap(a.m_fragment_shader, b.m_fragment_shader);
-    swap(a.m_uniform_cache, b.m_uniform_cache);
+    swap(a.m_instance_transform_location, b.m_instance_transform_location);
+    swap(a.m_instance_transform_uniform, b.m_instance_transform_uniform);
+    swap(a.m_uniforms, b.m_uniforms);
+    swap(a.m_uniform_blocks, b.m_uniform_blocks);
+    swap(a.m_properties, b.m_properties);
 }
 
 } // namespace game_engine::graphics
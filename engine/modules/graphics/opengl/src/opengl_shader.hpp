@@ -1,11 +1,16 @@
 #pragma once
 
+#include <span>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+#include <vector>
 
 #include <engine/graphics/property.hpp>
 #include <engine/graphics/shader.hpp>
 
+#include <modules/graphics/property_buffer.hpp>
+#include <modules/graphics/renderer_module.hpp>
+
 namespace game_engine::graphics
 {
 
@@ -13,6 +18,28 @@ class OpenGLShader final
 {
 public:
 
+    /// Name of the mat4 vertex attribute instanced draws read the transform from, other draws set it as a constant.
+    /// Shaders without it get the transform as the InstanceTransformProperty uniform, one draw per instance.
+    static constexpr const char* InstanceTransformAttribute = "instance_model";
+
+    /// @brief Active uniform of the linked program.
+    struct UniformInfo
+    {
+        std::string name;       ///< Name without the "[0]" suffix of arrays, members of blocks are qualified by the block.
+        unsigned int type = 0;  ///< GL type, e.g. GL_FLOAT_MAT4.
+        int size          = 0;  ///< Number of array elements, 1 for non-arrays.
+        int location      = -1; ///< -1 for members of uniform blocks.
+    };
+
+    /// @brief Active uniform block of the linked program.
+    struct UniformBlockInfo
+    {
+        std::string name;
+        unsigned int index = 0;
+        int data_size      = 0; ///< Size of the block's buffer, in bytes.
+        int binding        = 0;
+    };
+
     OpenGLShader();
     ~OpenGLShader();
 
@@ -26,12 +53,50 @@ public:
     bool IsValid() const noexcept;
     void Clear() noexcept;
 
-    void Use() const;
-    void SetProperty(const Property& property) const;
+    /// @brief Returns the program, it has to be in use before the calls below.
+    unsigned int GetProgram() const noexcept;
+
+    void SetProperty(const PropertyBuffer& buffer, const PackedProperty& property) const;
+
+    /// @brief Sets the InstanceTransformProperty uniform, if the shader has it.
+    void SetInstanceTransform(const Matrix4& transform) const;
+
+    /// @brief Sets the value InstanceTransformAttribute takes while its arrays are disabled, i.e. in draws that
+    /// aren't instanced. Does nothing if the shader doesn't declare it.
+    void SetInstanceTransformAttribute(const Matrix4& transform) const;
+
+    /// @brief Returns the location of InstanceTransformAttribute, -1 if the shader doesn't declare it.
+    int GetInstanceTransformLocation() const noexcept;
+
+    /// @brief Returns the active uniforms sorted by name, reflected once when the program is linked.
+    std::span<const UniformInfo> GetUniforms() const noexcept;
+
+    /// @brief Returns the active uniform blocks sorted by name.
+    std::span<const UniformBlockInfo> GetUniformBlocks() const noexcept;
+
+    /// @brief Looks the uniform up in the reflection table, null if the program has no such active uniform.
+    const UniformInfo* FindUniform(std::string_view name) const noexcept;
+
+    /// @brief Returns the uniforms outside of blocks that a property type can set.
+    std::vector<ShaderProperty> GetProperties() const;
+
+    /// @brief Keeps the locations of the properties by their id index, SetProperty only sets resolved properties.
+    void ResolveProperties(std::span<const ShaderProperty> properties);
 
 private:
 
-    int GetUniformLocation(const std::string& name) const;
+    /// @brief Uniform location of a resolved property.
+    struct ResolvedProperty
+    {
+        int location                 = -1;
+        std::uint32_t accepted_types = 0; ///< See ShaderProperty::accepted_types.
+    };
+
+    /// @brief Fills the reflection tables from the linked program.
+    void ReflectUniforms();
+
+    /// @brief Returns the uniform location of the property, -1 if it wasn't resolved or its type doesn't match.
+    int GetPropertyLocation(const PackedProperty& property) const noexcept;
 
     friend void swap(OpenGLShader& a, OpenGLShader& b) noexcept;
 
@@ -39,7 +104,13 @@ private:
     unsigned int m_vertex_shader   = 0;
     unsigned int m_fragment_shader = 0;
 
-    mutable std::unordered_map<std::string, int> m_uniform_cache;
+    int m_instance_transform_location = -1;
+    int m_instance_transform_uniform  = -1;
+
+    std::vector<UniformInfo> m_uniforms;
+    std::vector<UniformBlockInfo> m_uniform_blocks;
+
+    std::vector<ResolvedProperty> m_properties; ///< Indexed by PropertyId::GetIndex.
 };
 
 } // namespace game_engine::graphics
@@ -0,0 +1,63 @@
+#include "opengl_state.hpp"
+
+namespace game_engine::graphics
+{
+
+OpenGLState::OpenGLState()
+{
+    Invalidate();
+}
+
+OpenGLState::~OpenGLState() = default;
+
+void OpenGLState::UseProgram(GLuint program)
+{
+    if (Change(m_program, program)) {
+        glUseProgram(program);
+    }
+}
+
+void OpenGLState::BindVertexArray(GLuint vao)
+{
+    if (Change(m_vao, vao)) {
+        glBindVertexArray(vao);
+    }
+}
+
+void OpenGLState::BindArrayBuffer(GLuint buffer)
+{
+    if (Change(m_array_buffer, buffer)) {
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    }
+}
+
+void OpenGLState::Invalidate() noexcept
+{
+    m_program      = UnknownName;
+    m_vao          = UnknownName;
+    m_array_buffer = UnknownName;
+}
+
+const OpenGLState::Stats& OpenGLState::GetStats() const noexcept
+{
+    return m_stats;
+}
+
+void OpenGLState::ResetStats() noexcept
+{
+    m_stats = {};
+}
+
+bool OpenGLState::Change(GLuint& current, GLuint value) noexcept
+{
+    if (current == value) {
+        ++m_stats.skipped;
+        return false;
+    }
+
+    ++m_stats.issued;
+    current = value;
+    return true;
+}
+
+} // namespace game_engine::graphics
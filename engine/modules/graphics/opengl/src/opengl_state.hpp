@@ -0,0 +1,52 @@
+#pragma once
+
+#include <modules/graphics/renderer_module.hpp>
+
+#include <glad/glad.h>
+
+namespace game_engine::graphics
+{
+
+/// @brief Shadow copy of the GL bindings the renderer changes per draw.
+/// Calls that would set the value already in place are skipped. Code that changes the bindings directly
+/// has to call Invalidate, so the next calls are issued again.
+class OpenGLState final
+{
+public:
+
+    using Stats = StateChangeStats;
+
+    OpenGLState();
+    ~OpenGLState();
+
+    OpenGLState(const OpenGLState&) = delete;
+    OpenGLState(OpenGLState&&)      = delete;
+
+    OpenGLState& operator=(const OpenGLState&) = delete;
+    OpenGLState& operator=(OpenGLState&&)      = delete;
+
+    void UseProgram(GLuint program);
+    void BindVertexArray(GLuint vao);
+    void BindArrayBuffer(GLuint buffer);
+
+    /// @brief Forgets the tracked values, the next call of each setter is issued.
+    void Invalidate() noexcept;
+
+    const Stats& GetStats() const noexcept;
+    void ResetStats() noexcept;
+
+private:
+
+    static constexpr GLuint UnknownName = ~GLuint{0};
+
+    /// @brief Counts the call and tells if it has to be issued.
+    bool Change(GLuint& current, GLuint value) noexcept;
+
+    Stats m_stats;
+
+    GLuint m_program      = UnknownName;
+    GLuint m_vao          = UnknownName;
+    GLuint m_array_buffer = UnknownName;
+};
+
+} // namespace game_engine::graphics
@@ -1,5 +1,11 @@
 #include "stub_renderer.hpp"
 
+#include <stdexcept>
+
+#include <engine/graphics/mesh.hpp>
+#include <engine/graphics/shader.hpp>
+#include <engine/graphics/texture.hpp>
+
 namespace game_engine::graphics
 {
 
@@ -16,38 +22,123 @@ bool StubRenderer::Init()
 }
 
 void StubRenderer::Shutdown() noexcept
-{}
+{
+    UnloadAll();
+}
 
-bool StubRenderer::Load(const std::shared_ptr<IMesh>& mesh)
+RenderHandle StubRenderer::Load(const std::shared_ptr<IMesh>& mesh)
 {
-    return true;
+    return m_meshes.Insert(mesh->GetId());
 }
 
-bool StubRenderer::Load(const std::shared_ptr<IShader>& shader)
+RenderHandle StubRenderer::Load(const std::shared_ptr<IShader>& shader)
 {
-    return true;
+    return m_shaders.Insert(shader->GetId());
 }
 
-bool StubRenderer::Load(const std::shared_ptr<ITexture>& texture)
+RenderHandle StubRenderer::Load(const std::shared_ptr<ITexture>& texture)
 {
-    return true;
+    return m_textures.Insert(texture->GetId());
 }
 
-void StubRenderer::Unload(ResourceType type, ResourceId id)
-{}
+void StubRenderer::Unload(ResourceType type, RenderHandle handle)
+{
+    switch (type) {
+        case ResourceType::Mesh:    m_meshes.Erase(handle); break;
+        case ResourceType::Shader:  m_shaders.Erase(handle); break;
+        case ResourceType::Texture: m_textures.Erase(handle); break;
+
+        default: break;
+    }
+}
 
 void StubRenderer::UnloadAll()
-{}
+{
+    m_meshes.Clear();
+    m_shaders.Clear();
+    m_textures.Clear();
+}
 
 void StubRenderer::Execute(const BeginFrameCommand& command)
-{}
+{
+    m_shader.reset();
+    m_mesh.reset();
+    m_draw_calls    = 0;
+    m_state_changes = {};
+}
 
 void StubRenderer::Execute(const EndFrameCommand& command)
-{}
+{
+    m_frame_draw_calls    = m_draw_calls;
+    m_frame_state_changes = m_state_changes;
+}
 
 void StubRenderer::Execute(const RenderCommand& command)
+{
+    // Same checks as a real renderer, so stale handles show up without a GPU
+    if (!m_shaders.Contains(command.shader)) {
+        throw std::runtime_error("Shader not found");
+    }
+
+    if (!m_meshes.Contains(command.mesh)) {
+        throw std::runtime_error("Mesh not found");
+    }
+
+    // A real renderer draws a mesh in one call
+    ++m_draw_calls;
+    ++m_stats.draws;
+    m_stats.instances += command.instance_count;
+
+    if (m_shader != command.shader) {
+        ++m_stats.shader_changes;
+        ++m_state_changes.issued;
+        m_shader = command.shader;
+    } else {
+        ++m_state_changes.skipped;
+    }
+
+    if (m_mesh != command.mesh) {
+        ++m_stats.mesh_changes;
+        ++m_state_changes.issued;
+        m_mesh = command.mesh;
+    } else {
+        ++m_state_changes.skipped;
+    }
+}
+
+std::optional<std::vector<ShaderProperty>> StubRenderer::GetShaderProperties(RenderHandle shader) const
+{
+    // Shaders aren't compiled, there is nothing to reflect
+    return std::nullopt;
+}
+
+void StubRenderer::ResolveShaderProperties(RenderHandle shader, std::span<const ShaderProperty> properties)
 {}
 
+std::uint32_t StubRenderer::GetDrawCallsCount() const noexcept
+{
+    return m_frame_draw_calls;
+}
+
+StateChangeStats StubRenderer::GetStateChanges() const noexcept
+{
+    return m_frame_state_changes;
+}
+
+#pragma endregion
+
+#pragma region StubRenderer methods
+
+const StubRenderer::Stats& StubRenderer::GetStats() const noexcept
+{
+    return m_stats;
+}
+
+void StubRenderer::ResetStats() noexcept
+{
+    m_stats = {};
+}
+
 #pragma endregion
 
 } // namespace game_engine::graphics
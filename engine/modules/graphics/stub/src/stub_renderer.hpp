@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstdint>
+#include <optional>
+
 #include <modules/graphics/renderer_module.hpp>
 
 namespace game_engine::graphics
@@ -9,6 +12,15 @@ class StubRenderer final : public IRendererModule
 {
 public:
 
+    /// @brief Counts of the state changes a real renderer would make for the executed commands.
+    struct Stats
+    {
+        std::uint64_t draws          = 0;
+        std::uint64_t instances      = 0; ///< Objects drawn, an instanced draw counts all its instances.
+        std::uint64_t shader_changes = 0; ///< Draws using another shader than the previous draw of the frame.
+        std::uint64_t mesh_changes   = 0; ///< Draws using another mesh than the previous draw of the frame.
+    };
+
     StubRenderer();
     ~StubRenderer() override;
 
@@ -16,16 +28,44 @@ public:
     bool Init() override;
     void Shutdown() noexcept override;
 
-    bool Load(const std::shared_ptr<IMesh>& mesh) override;
-    bool Load(const std::shared_ptr<IShader>& shader) override;
-    bool Load(const std::shared_ptr<ITexture>& texture) override;
+    RenderHandle Load(const std::shared_ptr<IMesh>& mesh) override;
+    RenderHandle Load(const std::shared_ptr<IShader>& shader) override;
+    RenderHandle Load(const std::shared_ptr<ITexture>& texture) override;
 
-    void Unload(ResourceType type, ResourceId id) override;
+    void Unload(ResourceType type, RenderHandle handle) override;
     void UnloadAll() override;
 
     void Execute(const BeginFrameCommand& command) override;
     void Execute(const EndFrameCommand& command) override;
     void Execute(const RenderCommand& command) override;
+
+    std::optional<std::vector<ShaderProperty>> GetShaderProperties(RenderHandle shader) const override;
+    void ResolveShaderProperties(RenderHandle shader, std::span<const ShaderProperty> properties) override;
+
+    std::uint32_t GetDrawCallsCount() const noexcept override;
+    StateChangeStats GetStateChanges() const noexcept override;
+
+    // StubRenderer methods
+
+    /// @brief Returns the counts since the last reset. Read them when the render thread is idle.
+    const Stats& GetStats() const noexcept;
+    void ResetStats() noexcept;
+
+private:
+
+    HandleTable<ResourceId> m_meshes;
+    HandleTable<ResourceId> m_shaders;
+    HandleTable<ResourceId> m_textures;
+
+    Stats m_stats;
+    std::optional<RenderHandle> m_shader;
+    std::optional<RenderHandle> m_mesh;
+
+    std::uint32_t m_draw_calls       = 0; ///< Draw calls of the current frame.
+    std::uint32_t m_frame_draw_calls = 0; ///< Draw calls of the last finished frame.
+
+    StateChangeStats m_state_changes;       ///< Program and vertex array changes of the current frame.
+    StateChangeStats m_frame_state_changes; ///< Same for the last finished frame.
 };
 
 } // namespace game_engine::graphics
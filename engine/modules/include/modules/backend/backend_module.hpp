@@ -1,5 +1,6 @@
 #pragma once
 
+#include <filesystem>
 #include <memory>
 
 #include <engine/events/window_events.hpp>
@@ -28,6 +29,14 @@ public:
 
     virtual void PollEvents() const = 0;
 
+    /// @brief Makes PollEvents deliver the events of a recording instead of the real ones.
+    /// @param file    Recording written by the engine, see modules/backend/event_record.hpp.
+    /// @return False if the file can't be read or the backend doesn't support replay.
+    virtual bool ReplayEvents(const std::filesystem::path& file)
+    {
+        return false;
+    }
+
     virtual void MakeContextCurrent() const = 0;
     virtual void DropCurrentContext() const = 0;
     virtual void SwapBuffers() const        = 0;
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+
+#include <engine/events/window_events.hpp>
+
+namespace game_engine::backend
+{
+
+/// @brief Binary layout of recorded backend events, shared by the engine recorder and the stub backend replay.
+///
+/// A file starts with EventRecordMagic and EventRecordVersion, followed by fixed-size little-endian records:
+/// timestamp (u64, nanoseconds since recording start), frame (u32, PollEvents call index), type (u8)
+/// and three i32 payload values.
+
+inline constexpr std::array<char, 4> EventRecordMagic = {'E', 'V', 'R', 'C'};
+inline constexpr std::uint32_t EventRecordVersion     = 1;
+
+enum class EventRecordType : std::uint8_t
+{
+    KeyboardInput  = 0,
+    WindowResize   = 1,
+    WindowMove     = 2,
+    WindowClose    = 3,
+    WindowFocus    = 4,
+    WindowIconify  = 5,
+    WindowMaximize = 6,
+};
+
+struct EventRecord
+{
+    std::uint64_t timestamp = 0;                            ///< Nanoseconds since the recording started.
+    std::uint32_t frame     = 0;                            ///< Index of the PollEvents call that produced the event.
+    EventRecordType type    = EventRecordType::WindowClose; ///< Type of the recorded event.
+    std::array<std::int32_t, 3> payload{};                  ///< Event fields, meaning depends on the type.
+};
+
+namespace event_record_details
+{
+
+template <typename T>
+void WriteLittleEndian(std::ostream& stream, T value)
+{
+    std::array<char, sizeof(T)> bytes{};
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        bytes[i] = static_cast<char>((static_cast<std::uint64_t>(value) >> (i * 8)) & 0xFF);
+    }
+    stream.write(bytes.data(), bytes.size());
+}
+
+template <typename T>
+bool ReadLittleEndian(std::istream& stream, T& value)
+{
+    std::array<char, sizeof(T)> bytes{};
+    if (!stream.read(bytes.data(), bytes.size())) {
+        return false;
+    }
+
+    std::uint64_t result = 0;
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        result |= static_cast<std::uint64_t>(static_cast<unsigned char>(bytes[i])) << (i * 8);
+    }
+    value = static_cast<T>(result);
+    return true;
+}
+
+} // namespace event_record_details
+
+/// @brief Writes the file header.
+inline void WriteEventRecordHeader(std::ostream& stream)
+{
+    stream.write(EventRecordMagic.data(), EventRecordMagic.size());
+    event_record_details::WriteLittleEndian(stream, EventRecordVersion);
+}
+
+/// @brief Reads and checks the file header.
+/// @return True if the stream starts with a supported header.
+inline bool ReadEventRecordHeader(std::istream& stream)
+{
+    std::array<char, 4> magic{};
+    std::uint32_t version = 0;
+    if (!stream.read(magic.data(), magic.size()) || !event_record_details::ReadLittleEndian(stream, version)) {
+        return false;
+    }
+
+    return magic == EventRecordMagic && version == EventRecordVersion;
+}
+
+inline void WriteEventRecord(std::ostream& stream, const EventRecord& record)
+{
+    using namespace event_record_details;
+
+    WriteLittleEndian(stream, record.timestamp);
+    WriteLittleEndian(stream, record.frame);
+    WriteLittleEndian(stream, static_cast<std::uint8_t>(record.type));
+    for (const auto value : record.payload) {
+        WriteLittleEndian(stream, static_cast<std::uint32_t>(value));
+    }
+}
+
+/// @return False at the end of the stream or if the record is truncated or has an unknown type.
+inline bool ReadEventRecord(std::istream& stream, EventRecord& record)
+{
+    using namespace event_record_details;
+
+    std::uint8_t type = 0;
+    if (!ReadLittleEndian(stream, record.timestamp) || !ReadLittleEndian(stream, record.frame) || !ReadLittleEndian(stream, type)) {
+        return false;
+    }
+
+    for (auto& value : record.payload) {
+        std::uint32_t bits = 0;
+        if (!ReadLittleEndian(stream, bits)) {
+            return false;
+        }
+        value = static_cast<std::int32_t>(bits);
+    }
+
+    if (type > static_cast<std::uint8_t>(EventRecordType::WindowMaximize)) {
+        return false;
+    }
+
+    record.type = static_cast<EventRecordType>(type);
+    return true;
+}
+
+inline EventRecord MakeEventRecord(const KeyboardInputEvent& event)
+{
+    const auto key       = static_cast<std::int32_t>(event.key);
+    const auto action    = static_cast<std::int32_t>(event.action);
+    const auto modifiers = static_cast<std::int32_t>(event.modifiers);
+
+    return {.type = EventRecordType::KeyboardInput, .payload = {key, action, modifiers}};
+}
+
+inline EventRecord MakeEventRecord(const WindowResizeEvent& event)
+{
+    return {.type = EventRecordType::WindowResize, .payload = {event.width, event.height, 0}};
+}
+
+inline EventRecord MakeEventRecord(const WindowMoveEvent& event)
+{
+    return {.type = EventRecordType::WindowMove, .payload = {event.xpos, event.ypos, 0}};
+}
+
+inline EventRecord MakeEventRecord(const WindowCloseEvent&)
+{
+    return {.type = EventRecordType::WindowClose};
+}
+
+inline EventRecord MakeEventRecord(const WindowFocusEvent& event)
+{
+    return {.type = EventRecordType::WindowFocus, .payload = {event.focused ? 1 : 0, 0, 0}};
+}
+
+inline EventRecord MakeEventRecord(const WindowIconifyEvent& event)
+{
+    return {.type = EventRecordType::WindowIconify, .payload = {event.iconified ? 1 : 0, 0, 0}};
+}
+
+inline EventRecord MakeEventRecord(const WindowMaximizeEvent& event)
+{
+    return {.type = EventRecordType::WindowMaximize, .payload = {event.maximized ? 1 : 0, 0, 0}};
+}
+
+/// @brief Restores the event stored in the record and passes it to the visitor.
+/// @param record     The record to decode.
+/// @param visitor    Callable accepting every backend event type.
+template <typename TVisitor>
+void VisitEventRecord(const EventRecord& record, TVisitor&& visitor)
+{
+    const auto& p = record.payload;
+    switch (record.type) {
+        case EventRecordType::KeyboardInput:
+            visitor(KeyboardInputEvent{static_cast<KeyCode>(p[0]), static_cast<KeyAction>(p[1]), static_cast<KeyModifier>(p[2])});
+            break;
+        case EventRecordType::WindowResize:   visitor(WindowResizeEvent{p[0], p[1]}); break;
+        case EventRecordType::WindowMove:     visitor(WindowMoveEvent{p[0], p[1]}); break;
+        case EventRecordType::WindowClose:    visitor(WindowCloseEvent{}); break;
+        case EventRecordType::WindowFocus:    visitor(WindowFocusEvent{p[0] != 0}); break;
+        case EventRecordType::WindowIconify:  visitor(WindowIconifyEvent{p[0] != 0}); break;
+        case EventRecordType::WindowMaximize: visitor(WindowMaximizeEvent{p[0] != 0}); break;
+    }
+}
+
+} // namespace game_engine::backend
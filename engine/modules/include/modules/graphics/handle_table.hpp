@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace game_engine::graphics
+{
+
+/// @brief 32-bit reference to an object in a HandleTable: the slot index and the generation of the slot.
+/// The default handle is invalid, no table gives it out.
+class RenderHandle final
+{
+public:
+
+    static constexpr std::uint32_t IndexBits     = 20;
+    static constexpr std::uint32_t MaxIndex      = (1u << IndexBits) - 1;
+    static constexpr std::uint32_t MaxGeneration = (1u << (32 - IndexBits)) - 1;
+
+    constexpr RenderHandle() noexcept = default;
+
+    constexpr RenderHandle(std::uint32_t index, std::uint32_t generation) noexcept
+        : m_value((generation << IndexBits) | (index & MaxIndex))
+    {}
+
+    constexpr std::uint32_t GetIndex() const noexcept
+    {
+        return m_value & MaxIndex;
+    }
+
+    constexpr std::uint32_t GetGeneration() const noexcept
+    {
+        return m_value >> IndexBits;
+    }
+
+    constexpr bool IsValid() const noexcept
+    {
+        return GetGeneration() != 0;
+    }
+
+    constexpr bool operator==(const RenderHandle&) const noexcept = default;
+
+private:
+
+    std::uint32_t m_value = 0;
+};
+
+/// @brief Slot map of the objects a renderer module loads.
+/// Lookups are a bounds check and an array index. Erasing bumps the generation of the slot, so handles to erased
+/// objects are detected instead of reaching the object that reuses the slot. A slot whose generation runs out is
+/// retired for good.
+template <typename T>
+class HandleTable final
+{
+public:
+
+    HandleTable() = default;
+
+    HandleTable(const HandleTable&) = delete;
+    HandleTable(HandleTable&&)      = default;
+
+    HandleTable& operator=(const HandleTable&) = delete;
+    HandleTable& operator=(HandleTable&&)      = default;
+
+    /// @brief Stores the object.
+    /// @return Invalid handle if all slots are taken.
+    RenderHandle Insert(T value)
+    {
+        std::uint32_t index = 0;
+        if (!m_free.empty()) {
+            index = m_free.back();
+            m_free.pop_back();
+        } else if (m_slots.size() <= RenderHandle::MaxIndex) {
+            index = static_cast<std::uint32_t>(m_slots.size());
+            m_slots.emplace_back();
+        } else {
+            return {};
+        }
+
+        Slot& slot = m_slots[index];
+        slot.value.emplace(std::move(value));
+        ++m_size;
+
+        return {index, slot.generation};
+    }
+
+    /// @brief Tells if the handle refers to an object of the table.
+    bool Contains(RenderHandle handle) const noexcept
+    {
+        const std::uint32_t index = handle.GetIndex();
+        return index < m_slots.size() && m_slots[index].value && m_slots[index].generation == handle.GetGeneration();
+    }
+
+    /// @brief Returns the object, null if the handle is invalid or stale.
+    T* Get(RenderHandle handle) noexcept
+    {
+        return Contains(handle) ? &*m_slots[handle.GetIndex()].value : nullptr;
+    }
+
+    const T* Get(RenderHandle handle) const noexcept
+    {
+        return Contains(handle) ? &*m_slots[handle.GetIndex()].value : nullptr;
+    }
+
+    /// @return False if the handle is invalid or stale.
+    bool Erase(RenderHandle handle)
+    {
+        if (!Contains(handle)) {
+            return false;
+        }
+
+        Slot& slot = m_slots[handle.GetIndex()];
+        slot.value.reset();
+        --m_size;
+
+        if (slot.generation < RenderHandle::MaxGeneration) {
+            ++slot.generation;
+            m_free.push_back(handle.GetIndex());
+        }
+
+        return true;
+    }
+
+    /// @brief Erases all objects, the handles given out so far stay stale.
+    void Clear()
+    {
+        for (std::uint32_t index = 0; index < m_slots.size(); ++index) {
+            if (m_slots[index].value) {
+                Erase({index, m_slots[index].generation});
+            }
+        }
+    }
+
+    std::size_t GetSize() const noexcept
+    {
+        return m_size;
+    }
+
+private:
+
+    struct Slot
+    {
+        std::optional<T> value;
+        std::uint32_t generation = 1;
+    };
+
+    std::vector<Slot> m_slots;
+    std::vector<std::uint32_t> m_free;
+    std::size_t m_size = 0;
+};
+
+} // namespace game_engine::graphics
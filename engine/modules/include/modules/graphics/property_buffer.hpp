@@ -0,0 +1,166 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include <engine/graphics/property.hpp>
+#include <engine/resource_management/resource.hpp>
+
+namespace game_engine::graphics
+{
+
+enum class PropertyType : std::uint8_t
+{
+    Int,
+    Float,
+    Vector2,
+    Vector3,
+    Vector4,
+    Matrix3,
+    Matrix4,
+    Texture, ///< Stored as the ResourceId of the texture, 0 for no texture.
+};
+
+/// @brief Header of a property value packed into a PropertyBuffer.
+struct PackedProperty
+{
+    PropertyId id;
+    PropertyType type    = PropertyType::Int;
+    std::uint32_t offset = 0; ///< Offset of the value in the buffer data, in bytes.
+    std::uint32_t size   = 0; ///< Size of the value, in bytes.
+};
+
+/// @brief Properties of one command in the frame's PropertyBuffer.
+struct PropertyRange
+{
+    std::uint32_t first = 0;
+    std::uint32_t count = 0;
+};
+
+/// @brief Linear per-frame storage of the draw properties.
+/// Values are packed back to back without their names, textures without their reference counts. Appending only
+/// grows two vectors, which keep their capacity when the buffer is cleared.
+class PropertyBuffer final
+{
+public:
+
+    PropertyBuffer() = default;
+
+    PropertyBuffer(const PropertyBuffer&) = delete;
+    PropertyBuffer(PropertyBuffer&&)      = default;
+
+    PropertyBuffer& operator=(const PropertyBuffer&) = delete;
+    PropertyBuffer& operator=(PropertyBuffer&&)      = default;
+
+    PropertyRange Append(std::span<const PropertyBinding> properties)
+    {
+        const PropertyRange range{
+            .first = static_cast<std::uint32_t>(m_properties.size()),
+            .count = static_cast<std::uint32_t>(properties.size()),
+        };
+
+        for (const auto& property : properties) {
+            std::visit([this, &property](const auto& value) { Pack(property.id, value); }, property.value);
+        }
+
+        return range;
+    }
+
+    std::span<const PackedProperty> Get(PropertyRange range) const noexcept
+    {
+        return std::span(m_properties).subspan(range.first, range.count);
+    }
+
+    std::span<PackedProperty> Get(PropertyRange range) noexcept
+    {
+        return std::span(m_properties).subspan(range.first, range.count);
+    }
+
+    std::span<const std::byte> GetData(const PackedProperty& property) const noexcept
+    {
+        return std::span(m_data).subspan(property.offset, property.size);
+    }
+
+    /// @brief Returns a copy of the value, T must match the property type.
+    template <typename T>
+    T GetValue(const PackedProperty& property) const noexcept
+    {
+        T value;
+        std::memcpy(&value, m_data.data() + property.offset, sizeof(T));
+        return value;
+    }
+
+    std::size_t GetPropertiesCount() const noexcept
+    {
+        return m_properties.size();
+    }
+
+    std::size_t GetDataSize() const noexcept
+    {
+        return m_data.size();
+    }
+
+    void Reserve(std::size_t properties, std::size_t data_size)
+    {
+        m_properties.reserve(properties);
+        m_data.reserve(data_size);
+    }
+
+    void Clear() noexcept
+    {
+        m_properties.clear();
+        m_data.clear();
+    }
+
+private:
+
+    template <typename T>
+    void Pack(PropertyId id, const T& value)
+    {
+        if constexpr (std::is_same_v<T, std::shared_ptr<ITexture>>) {
+            Pack(id, PropertyType::Texture, value ? value->GetId() : ResourceId{0});
+        } else if constexpr (std::is_same_v<T, int>) {
+            Pack(id, PropertyType::Int, value);
+        } else if constexpr (std::is_same_v<T, float>) {
+            Pack(id, PropertyType::Float, value);
+        } else if constexpr (std::is_same_v<T, Vector2>) {
+            Pack(id, PropertyType::Vector2, value);
+        } else if constexpr (std::is_same_v<T, Vector3>) {
+            Pack(id, PropertyType::Vector3, value);
+        } else if constexpr (std::is_same_v<T, Vector4>) {
+            Pack(id, PropertyType::Vector4, value);
+        } else if constexpr (std::is_same_v<T, Matrix3>) {
+            Pack(id, PropertyType::Matrix3, value);
+        } else if constexpr (std::is_same_v<T, Matrix4>) {
+            Pack(id, PropertyType::Matrix4, value);
+        } else {
+            static_assert(!std::is_same_v<T, T>, "Unsupported property type");
+        }
+    }
+
+    template <typename T>
+    void Pack(PropertyId id, PropertyType type, const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        m_properties.push_back({
+            .id     = id,
+            .type   = type,
+            .offset = static_cast<std::uint32_t>(m_data.size()),
+            .size   = static_cast<std::uint32_t>(sizeof(T)),
+        });
+
+        const auto* bytes = reinterpret_cast<const std::byte*>(&value);
+        m_data.insert(m_data.end(), bytes, bytes + sizeof(T));
+    }
+
+    std::vector<PackedProperty> m_properties;
+    std::vector<std::byte> m_data;
+};
+
+} // namespace game_engine::graphics
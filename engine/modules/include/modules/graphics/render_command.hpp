@@ -1,26 +1,40 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
-#include <vector>
+#include <span>
+#include <string_view>
 
 #include <engine/graphics/property.hpp>
 #include <engine/resource_management/resource.hpp>
 
+#include <modules/graphics/handle_table.hpp>
+#include <modules/graphics/property_buffer.hpp>
+
 namespace game_engine::graphics
 {
 
+/// @brief Matrix4 property holding the object transform. Draws that differ only in it are merged into one instanced
+/// command, their transforms go to BeginFrameCommand::instance_transforms.
+inline constexpr std::string_view InstanceTransformProperty = "model";
+
 struct BeginFrameCommand
-{};
+{
+    const PropertyBuffer* properties = nullptr;   ///< Properties of the frame's commands, valid until EndFrameCommand.
+    std::span<const Matrix4> instance_transforms; ///< Transforms of the frame's instanced commands, valid until EndFrameCommand.
+};
 
 struct EndFrameCommand
 {};
 
 struct RenderCommand
 {
-    ResourceId mesh;
-    ResourceId shader;
-    std::vector<Property> properties;
+    RenderHandle mesh;   ///< Handle given by IRendererModule::Load.
+    RenderHandle shader; ///< Handle given by IRendererModule::Load.
+    PropertyRange properties; ///< Properties in BeginFrameCommand::properties.
     std::uint32_t instance_count = 1;
+    std::uint32_t first_instance = 0; ///< First of the instance_count transforms in BeginFrameCommand::instance_transforms.
+    std::uint64_t sort_key       = 0; ///< Commands of a frame are executed in ascending key order.
 };
 
 } // namespace game_engine::graphics
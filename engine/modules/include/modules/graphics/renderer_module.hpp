@@ -1,6 +1,11 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
 
 #include <modules/graphics/render_command.hpp>
 
@@ -14,6 +19,27 @@ class ITexture;
 namespace game_engine::graphics
 {
 
+/// @brief Returns the bit of the property type in ShaderProperty::accepted_types.
+constexpr std::uint32_t GetPropertyTypeBit(PropertyType type) noexcept
+{
+    return 1u << static_cast<std::uint32_t>(type);
+}
+
+/// @brief Uniform of a loaded shader that draw properties can set.
+struct ShaderProperty
+{
+    std::string name;
+    std::uint32_t accepted_types = 0; ///< GetPropertyTypeBit of every property type that can set the uniform.
+    PropertyId id;                    ///< Interned name, set by the engine before IRendererModule::ResolveShaderProperties.
+};
+
+/// @brief Bindings a module changed or skipped while executing a frame, see IRendererModule::GetStateChanges.
+struct StateChangeStats
+{
+    std::uint64_t issued  = 0; ///< State calls sent to the driver.
+    std::uint64_t skipped = 0; ///< State calls dropped because the value was already set.
+};
+
 class IRendererModule
 {
 public:
@@ -25,16 +51,33 @@ public:
     virtual bool Init()              = 0;
     virtual void Shutdown() noexcept = 0;
 
-    virtual bool Load(const std::shared_ptr<IMesh>& mesh)       = 0;
-    virtual bool Load(const std::shared_ptr<IShader>& shader)   = 0;
-    virtual bool Load(const std::shared_ptr<ITexture>& texture) = 0;
+    /// @brief Uploads the resource, every call creates a new GPU object.
+    /// @return Handle the render commands refer to the object by, throws if loading fails.
+    virtual RenderHandle Load(const std::shared_ptr<IMesh>& mesh)       = 0;
+    virtual RenderHandle Load(const std::shared_ptr<IShader>& shader)   = 0;
+    virtual RenderHandle Load(const std::shared_ptr<ITexture>& texture) = 0;
 
-    virtual void Unload(ResourceType type, ResourceId id) = 0;
-    virtual void UnloadAll()                              = 0;
+    /// @brief Frees the object, the handle and its copies become stale. Stale handles are ignored.
+    virtual void Unload(ResourceType type, RenderHandle handle) = 0;
+    virtual void UnloadAll()                                    = 0;
 
     virtual void Execute(const BeginFrameCommand& command) = 0;
     virtual void Execute(const EndFrameCommand& command)   = 0;
     virtual void Execute(const RenderCommand& command)     = 0;
+
+    /// @brief Returns the uniforms of the shader that properties can set, from the table reflected when it was loaded.
+    /// @return std::nullopt if the module doesn't reflect shaders, their properties aren't validated then.
+    virtual std::optional<std::vector<ShaderProperty>> GetShaderProperties(RenderHandle shader) const = 0;
+
+    /// @brief Resolves the uniforms of the shader once, before its first draw. Draws then find them by the id index.
+    /// @param properties    Result of GetShaderProperties with the ids set. Properties of other ids are ignored.
+    virtual void ResolveShaderProperties(RenderHandle shader, std::span<const ShaderProperty> properties) = 0;
+
+    /// @brief Returns the number of draw calls the last executed frame issued, counted up to its EndFrameCommand.
+    virtual std::uint32_t GetDrawCallsCount() const noexcept = 0;
+
+    /// @brief Returns the state changes of the last executed frame, counted up to its EndFrameCommand.
+    virtual StateChangeStats GetStateChanges() const noexcept = 0;
 };
 
 } // namespace game_engine::graphics
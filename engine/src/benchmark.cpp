@@ -0,0 +1,109 @@
+#include "benchmark.hpp"
+
+namespace
+{
+
+double PerSecond(std::size_t count, std::chrono::nanoseconds duration) noexcept
+{
+    if (duration <= std::chrono::nanoseconds::zero()) {
+        return 0.0;
+    }
+
+    return static_cast<double>(count) / std::chrono::duration<double>(duration).count();
+}
+
+void WriteTimings(std::ostream& stream, std::string_view name, const game_engine::PhaseTimings& timing)
+{
+    stream << "    \"" << name << "\": {"
+           << "\"samples\": " << timing.samples << ", "
+           << "\"min_ns\": " << timing.min.count() << ", "
+           << "\"avg_ns\": " << timing.average.count() << ", "
+           << "\"p50_ns\": " << timing.p50.count() << ", "
+           << "\"p90_ns\": " << timing.p90.count() << ", "
+           << "\"p99_ns\": " << timing.p99.count() << ", "
+           << "\"max_ns\": " << timing.max.count() << "}";
+}
+
+} // namespace
+
+namespace game_engine
+{
+
+#pragma region BenchmarkResult
+
+double BenchmarkResult::GetFramesPerSecond() const noexcept
+{
+    return PerSecond(frames, duration);
+}
+
+double BenchmarkResult::GetUpdatesPerSecond() const noexcept
+{
+    return PerSecond(updates, duration);
+}
+
+#pragma endregion
+
+std::string_view ToString(FramePhase phase) noexcept
+{
+    switch (phase) {
+        case FramePhase::PollEvents:      return "poll_events";
+        case FramePhase::Update:          return "update";
+        case FramePhase::Draw:            return "draw";
+        case FramePhase::Submit:          return "submit";
+        case FramePhase::Stall:           return "stall";
+        case FramePhase::Upload:          return "upload";
+        case FramePhase::RenderExecution: return "render_execution";
+        case FramePhase::SwapBuffers:     return "swap_buffers";
+        case FramePhase::Frame:           return "frame";
+    }
+
+    return "unknown";
+}
+
+std::string_view ToString(RenderLane lane) noexcept
+{
+    switch (lane) {
+        case RenderLane::Frame:      return "frame";
+        case RenderLane::Critical:   return "critical";
+        case RenderLane::Background: return "background";
+    }
+
+    return "unknown";
+}
+
+void WriteBenchmarkJson(std::ostream& stream, const BenchmarkResult& result)
+{
+    stream << "{\n";
+    stream << "  \"frames\": " << result.frames << ",\n";
+    stream << "  \"updates\": " << result.updates << ",\n";
+    stream << "  \"duration_ns\": " << result.duration.count() << ",\n";
+    stream << "  \"frames_per_second\": " << result.GetFramesPerSecond() << ",\n";
+    stream << "  \"updates_per_second\": " << result.GetUpdatesPerSecond() << ",\n";
+    stream << "  \"max_frames_in_flight\": " << result.stats.max_frames_in_flight << ",\n";
+    stream << "  \"skipped_frames\": " << result.stats.skipped_frames << ",\n";
+    stream << "  \"draw_calls\": " << result.stats.draw_calls << ",\n";
+    stream << "  \"state_changes\": " << result.stats.state_changes << ",\n";
+    stream << "  \"skipped_state_changes\": " << result.stats.skipped_state_changes << ",\n";
+    stream << "  \"phases\": {";
+
+    for (std::size_t i = 0; i < FramePhaseCount; ++i) {
+        const auto phase = static_cast<FramePhase>(i);
+
+        stream << (i == 0 ? "\n" : ",\n");
+        WriteTimings(stream, ToString(phase), result.stats[phase]);
+    }
+
+    stream << "\n  },\n";
+    stream << "  \"queue_latency\": {";
+
+    for (std::size_t i = 0; i < RenderLaneCount; ++i) {
+        const auto lane = static_cast<RenderLane>(i);
+
+        stream << (i == 0 ? "\n" : ",\n");
+        WriteTimings(stream, ToString(lane), result.stats[lane]);
+    }
+
+    stream << "\n  }\n}\n";
+}
+
+} // namespace game_engine
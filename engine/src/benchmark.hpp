@@ -0,0 +1,39 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <string_view>
+
+#include <engine/frame_stats.hpp>
+
+namespace game_engine
+{
+
+/// @brief Settings of the unthrottled benchmark run, see EngineImpl::EnableBenchmark.
+struct BenchmarkSettings
+{
+    std::size_t frames        = 1000; ///< Number of measured frames.
+    std::size_t warmup_frames = 100;  ///< Number of frames run before the measurement starts.
+};
+
+/// @brief Measurements of the frames after the warmup.
+struct BenchmarkResult
+{
+    std::size_t frames  = 0;
+    std::size_t updates = 0;
+    std::chrono::nanoseconds duration{};
+    FrameStats stats;
+
+    double GetFramesPerSecond() const noexcept;
+    double GetUpdatesPerSecond() const noexcept;
+};
+
+std::string_view ToString(FramePhase phase) noexcept;
+std::string_view ToString(RenderLane lane) noexcept;
+
+/// @brief Writes the result as a JSON object with the rates, the timings of every FramePhase and the queue latency
+/// of every RenderLane in nanoseconds.
+void WriteBenchmarkJson(std::ostream& stream, const BenchmarkResult& result);
+
+} // namespace game_engine
@@ -1,7 +1,10 @@
 #include "engine_impl.hpp"
 
-#include <thread>
+#include <algorithm>
 
+#include <engine/utils/profiler.hpp>
+
+#include <events/event_recorder.hpp>
 #include <graphics/renderer_impl.hpp>
 #include <resource_management/resource_manager_impl.hpp>
 
@@ -18,11 +21,17 @@ namespace game_engine
 
 EngineImpl::EngineImpl(const ModuleLocator& locator)
     : m_backend(locator.Get<backend::IBackendModule>())
-    , m_renderer(std::make_shared<RendererImpl>(locator))
+    , m_frame_stats(std::make_shared<FrameStatsCollector>())
+    , m_renderer(std::make_shared<RendererImpl>(locator, m_frame_stats))
     , m_resource_manager(std::make_shared<ResourceManagerImpl>())
     , m_event_system(std::make_shared<EventSystem>())
+    , m_event_recorder(std::make_unique<EventRecorder>())
     , m_game(locator.Get<IGame>())
-{}
+{
+    // Fast resizes and moves fire many events per PollEvents, deliver only the last one per frame
+    m_event_system->SetCoalescing<WindowResizeEvent>(CoalescePolicy::KeepLast);
+    m_event_system->SetCoalescing<WindowMoveEvent>(CoalescePolicy::KeepLast);
+}
 
 EngineImpl::~EngineImpl() = default;
 
@@ -62,6 +71,12 @@ std::shared_ptr<EventSystem> EngineImpl::GetEventSystem() const
     return m_event_system;
 }
 
+[[nodiscard]]
+FrameStats EngineImpl::GetFrameStats() const
+{
+    return m_frame_stats->GetStats();
+}
+
 //void EngineImpl::Render(const std::shared_ptr<graphics::IMesh>& mesh,
 //                        const std::shared_ptr<graphics::IShader>& shader,
 //                        const std::vector<graphics::Uniform>& uniforms)
@@ -90,6 +105,12 @@ int EngineImpl::run() noexcept
             return -1;
         }
 
+        m_renderer->SetFramesInFlight(static_cast<std::size_t>(std::max(settings.max_frames_in_flight, 1)),
+                                      settings.frame_backpressure);
+        m_renderer->SetTransparentSorting(settings.transparent_sorting);
+        m_renderer->SetAutomaticInstancing(settings.automatic_instancing);
+        m_renderer->SetUploadLane(settings.upload_lane);
+        m_renderer->SetUploadBudget(settings.upload_bytes_per_frame, settings.upload_time_per_frame);
         if (!m_renderer->Init()) {
             return -1;
         }
@@ -99,17 +120,35 @@ int EngineImpl::run() noexcept
         }
 
         SetupFrameRate(settings);
+        m_threading = settings.threading;
 
         m_backend->AttachBackendObserver(*this);
+        m_backend->AttachBackendObserver(*m_event_recorder);
 
         MainLoop();
 
+        m_backend->DetachBackendObserver(*m_event_recorder);
         m_backend->DetachBackendObserver(*this);
+        m_event_recorder->Close();
+
+        const auto& pacing = m_frame_pacer.GetStats();
+        std::cout << "EngineImpl frame pacing jitter: avg " << pacing.average_jitter.count() << "ns, max "
+                  << pacing.max_jitter.count() << "ns over " << pacing.waits << " waits" << std::endl;
 
         m_game->Shutdown();
         m_renderer->Shutdown();
         m_backend->Shutdown();
 
+        if (!m_trace_file.empty()) {
+            if (!profiler::Enabled) {
+                LOG_ERROR << "Profiler zones are disabled, build with ENABLE_PROFILER to record them" << std::endl;
+            }
+
+            if (!profiler::WriteChromeTrace(m_trace_file)) {
+                LOG_ERROR << "Failed to write trace to " << m_trace_file << std::endl;
+            }
+        }
+
         if (m_game.use_count() != 1) {
             LOG_ERROR << "Game instance leaked. Uses: " << m_game.use_count() << std::endl;
         }
@@ -133,49 +172,79 @@ int EngineImpl::run() noexcept
     return 0;
 }
 
+bool EngineImpl::StartEventRecording(const std::filesystem::path& file)
+{
+    return m_event_recorder->Open(file);
+}
+
+void EngineImpl::StopEventRecording()
+{
+    m_event_recorder->Close();
+}
+
+void EngineImpl::SetTraceFile(const std::filesystem::path& file)
+{
+    m_trace_file = file;
+}
+
+void EngineImpl::EnableBenchmark(const BenchmarkSettings& settings)
+{
+    m_benchmark = settings;
+}
+
+const BenchmarkResult& EngineImpl::GetBenchmarkResult() const noexcept
+{
+    return m_benchmark_result;
+}
+
+const FramePacer::Stats& EngineImpl::GetPacingStats() const noexcept
+{
+    return m_frame_pacer.GetStats();
+}
+
 #pragma endregion
 
 #pragma region BackendEventHandler
 
 void EngineImpl::OnEvent(const KeyboardInputEvent& event)
 {
-    m_event_system->ProcessEvent(event);
+    m_event_system->Enqueue(event);
 }
 
 // TODO: Handle window events
 // TODO: Save view aspect ratio on window resize
 void EngineImpl::OnEvent(const WindowResizeEvent& event)
 {
-    m_event_system->ProcessEvent(event);
+    m_event_system->Enqueue(event);
 }
 
 void EngineImpl::OnEvent(const WindowMoveEvent& event)
 {
-    m_event_system->ProcessEvent(event);
+    m_event_system->Enqueue(event);
 }
 
 void EngineImpl::OnEvent(const WindowCloseEvent& event)
 {
-    m_event_system->ProcessEvent(event);
+    m_event_system->Enqueue(event);
 
-    if (m_game->OnShouldClose()) {
+    if (!m_benchmark && m_game->OnShouldClose()) {
         SetShouldStopFlag();
     }
 }
 
 void EngineImpl::OnEvent(const WindowFocusEvent& event)
 {
-    m_event_system->ProcessEvent(event);
+    m_event_system->Enqueue(event);
 }
 
 void EngineImpl::OnEvent(const WindowIconifyEvent& event)
 {
-    m_event_system->ProcessEvent(event);
+    m_event_system->Enqueue(event);
 }
 
 void EngineImpl::OnEvent(const WindowMaximizeEvent& event)
 {
-    m_event_system->ProcessEvent(event);
+    m_event_system->Enqueue(event);
 }
 
 #pragma endregion
@@ -186,6 +255,9 @@ void EngineImpl::SetupFrameRate(const GameSettings& settings)
 {
     m_targetUpdateTime = Second / settings.update_rate;
     m_targetFrameTime  = Second / settings.frame_rate;
+
+    m_frame_pacer.SetPacing(settings.frame_pacing);
+    m_frame_pacer.SetSpinThreshold(settings.pacing_spin_threshold);
 }
 
 void EngineImpl::MainLoop()
@@ -196,31 +268,76 @@ void EngineImpl::MainLoop()
     std::chrono::nanoseconds updatesDeltaTime{0};
     std::chrono::nanoseconds framesDeltaTime{0};
 
+    PROFILE_THREAD("Main");
+
+    if (m_threading == ThreadingMode::SimulationThread) {
+        m_simulation_thread.Start([this] { Update(m_targetUpdateTime); });
+    }
+
+    if (m_benchmark) {
+        m_frame_stats->Reset();
+        m_benchmark_start = lastTime;
+    }
+
     while (!ShouldStop()) {
-        m_backend->PollEvents();
+        const TimePoint iterationStart = GetTime();
+
+        {
+            PROFILE_ZONE("MainLoop::PollEvents");
+            FrameStatsCollector::ScopedTimer timer(*m_frame_stats, FramePhase::PollEvents);
+
+            m_event_recorder->NextFrame();
+            m_backend->PollEvents();
+
+            // Events posted from other threads and queued backend events are delivered here, once per frame
+            m_event_system->Flush();
+        }
 
         const TimePoint nowTime = GetTime();
         auto frameDuration      = (nowTime - lastTime);
 
-        // Run the required number of updates
+        // Count the required number of updates
+        std::size_t updates = 0;
         updatesDeltaTime += frameDuration;
         while (updatesDeltaTime >= m_targetUpdateTime) {
-            Update(m_targetUpdateTime);
-            m_updates++;
+            updates++;
             updatesDeltaTime -= m_targetUpdateTime;
         }
 
-        // Render one frame
+        // Render at most one frame
+        bool render = false;
         framesDeltaTime += frameDuration;
         if (framesDeltaTime >= m_targetFrameTime) {
-            Render();
+            render = true;
+            framesDeltaTime -= m_targetFrameTime;
+        }
+
+        // Benchmark runs as fast as possible
+        if (m_benchmark) {
+            updates = 1;
+            render  = true;
+        }
+
+        {
+            PROFILE_ZONE("MainLoop::Step");
+            Step(updates, render);
+        }
+
+        m_updates += updates;
+        if (render) {
             m_frames++;
             m_totalFrames++;
-            framesDeltaTime -= m_targetFrameTime;
+            m_frame_stats->Record(FramePhase::Frame, GetTime() - iterationStart);
         }
 
         lastTime = nowTime;
 
+        if (m_benchmark) {
+            m_benchmark_updates += updates;
+            CountBenchmarkFrame();
+            continue;
+        }
+
         // Count fps and ups for one second
         if (nowTime - fpsCounterTime > std::chrono::seconds(1)) {
             fpsCounterTime     = nowTime;
@@ -228,21 +345,93 @@ void EngineImpl::MainLoop()
             m_framesPerSecond  = m_frames;
             m_updates          = 0;
             m_frames           = 0;
+
+            m_frame_stats->Rotate(m_updatesPerSecond, m_framesPerSecond);
+        }
+
+        // Wait for whichever comes first, the next update or the next frame
+        const auto untilUpdate = m_targetUpdateTime - updatesDeltaTime;
+        const auto untilFrame  = m_targetFrameTime - framesDeltaTime;
+        PROFILE_ZONE("MainLoop::Wait");
+        m_frame_pacer.WaitUntil(nowTime + std::min(untilUpdate, untilFrame));
+    }
+
+    m_simulation_thread.Stop();
+}
+
+void EngineImpl::Step(std::size_t updates, bool render)
+{
+    if (!m_simulation_thread.IsRunning()) {
+        for (std::size_t i = 0; i < updates; ++i) {
+            Update(m_targetUpdateTime);
         }
 
-        std::this_thread::sleep_for(std::chrono::nanoseconds(1));
+        if (updates != 0) {
+            m_game->OnSync();
+        }
+
+        if (render) {
+            Render();
+        }
+        return;
+    }
+
+    // Simulate the next state while the previous one is drawn
+    if (updates != 0) {
+        m_simulation_thread.Kick(updates);
+    }
+
+    if (render) {
+        Render();
+    }
+
+    if (updates != 0) {
+        m_simulation_thread.Wait();
+        m_game->OnSync();
     }
 }
 
+void EngineImpl::CountBenchmarkFrame()
+{
+    if (m_totalFrames == m_benchmark->warmup_frames) {
+        m_frame_stats->Reset();
+        m_benchmark_start   = GetTime();
+        m_benchmark_updates = 0;
+    }
+
+    if (m_totalFrames < m_benchmark->warmup_frames + m_benchmark->frames) {
+        return;
+    }
+
+    m_benchmark_result = {
+        .frames   = m_benchmark->frames,
+        .updates  = m_benchmark_updates,
+        .duration = GetTime() - m_benchmark_start,
+        .stats    = m_frame_stats->GetStats(),
+    };
+    m_benchmark_result.stats.updates_per_second = static_cast<std::size_t>(m_benchmark_result.GetUpdatesPerSecond());
+    m_benchmark_result.stats.frames_per_second  = static_cast<std::size_t>(m_benchmark_result.GetFramesPerSecond());
+
+    SetShouldStopFlag();
+}
+
 void EngineImpl::Update(std::chrono::nanoseconds elapsedTime)
 {
+    PROFILE_ZONE("IGame::OnUpdate");
+    FrameStatsCollector::ScopedTimer timer(*m_frame_stats, FramePhase::Update);
+
     m_game->OnUpdate(elapsedTime);
 }
 
 void EngineImpl::Render()
 {
-    m_game->OnDraw();
+    {
+        PROFILE_ZONE("IGame::OnDraw");
+        FrameStatsCollector::ScopedTimer timer(*m_frame_stats, FramePhase::Draw);
+        m_game->OnDraw();
+    }
 
+    FrameStatsCollector::ScopedTimer timer(*m_frame_stats, FramePhase::Submit);
     m_renderer->EndFrame();
 }
 
@@ -1,15 +1,24 @@
 
 #pragma once
 
+#include <filesystem>
+#include <optional>
+
 #include <engine/engine.hpp>
 #include <engine/game.hpp>
 
+#include <benchmark.hpp>
+#include <frame_pacer.hpp>
+#include <frame_stats_collector.hpp>
+#include <simulation_thread.hpp>
+
 #include <modules/backend/backend_module.hpp>
 #include <modules/module_locator.hpp>
 
 namespace game_engine
 {
 
+class EventRecorder;
 class ResourceManagerImpl;
 class RendererImpl;
 
@@ -39,8 +48,33 @@ public:
     [[nodiscard]]
     std::shared_ptr<EventSystem> GetEventSystem() const override;
 
+    [[nodiscard]]
+    FrameStats GetFrameStats() const override;
+
     ReturnCode run() noexcept;
 
+    /// @brief Starts writing every backend event to a binary file, replaying it with the stub backend
+    /// reproduces the session. Replaces a running recording.
+    /// @return False if the file can't be written.
+    bool StartEventRecording(const std::filesystem::path& file);
+
+    /// @brief Stops the event recording, if any.
+    void StopEventRecording();
+
+    /// @brief Sets the file the profiler trace is written to at shutdown.
+    /// Zones are only recorded in builds with the ENABLE_PROFILER option.
+    void SetTraceFile(const std::filesystem::path& file);
+
+    /// @brief Runs the main loop unthrottled, one update and one frame per iteration, and stops it
+    /// after the warmup and measured frames. Window close requests are ignored. Call before run.
+    void EnableBenchmark(const BenchmarkSettings& settings);
+
+    /// @brief Returns the measurements of the benchmark run, empty until it has finished.
+    const BenchmarkResult& GetBenchmarkResult() const noexcept;
+
+    /// @brief Returns how late the main loop woke up for its deadlines.
+    const FramePacer::Stats& GetPacingStats() const noexcept;
+
 private:
 
     // BackendEventHandler
@@ -55,23 +89,42 @@ private:
     void SetupFrameRate(const GameSettings& settings);
     void MainLoop();
 
+    /// @brief Runs the updates, on the simulation thread if there is one, and draws a frame if `render` is set.
+    void Step(std::size_t updates, bool render);
+
+    /// @brief Starts the measurement after the warmup and stops the main loop after the measured frames.
+    void CountBenchmarkFrame();
+
     void Update(std::chrono::nanoseconds elapsedTime);
     void Render();
 
     std::shared_ptr<backend::IBackendModule> m_backend;
+    std::shared_ptr<FrameStatsCollector> m_frame_stats;
 
     std::shared_ptr<RendererImpl> m_renderer;
     std::shared_ptr<ResourceManagerImpl> m_resource_manager;
     std::shared_ptr<EventSystem> m_event_system;
+    std::unique_ptr<EventRecorder> m_event_recorder;
+    std::filesystem::path m_trace_file;
 
     std::shared_ptr<IGame> m_game;
 
     TimePoint m_engineStartTime;
-    bool m_shouldStop = false;
+    std::atomic<bool> m_shouldStop = false;
 
     std::chrono::nanoseconds m_targetUpdateTime{};
     std::chrono::nanoseconds m_targetFrameTime{};
 
+    FramePacer m_frame_pacer;
+
+    std::optional<BenchmarkSettings> m_benchmark;
+    BenchmarkResult m_benchmark_result;
+    TimePoint m_benchmark_start;
+    std::size_t m_benchmark_updates = 0;
+
+    ThreadingMode m_threading = ThreadingMode::SingleThreaded;
+    SimulationThread m_simulation_thread;
+
     std::size_t m_updates          = 0;
     std::size_t m_frames           = 0;
     std::size_t m_updatesPerSecond = 0;
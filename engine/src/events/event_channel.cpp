@@ -0,0 +1,194 @@
+#include <algorithm>
+#include <bit>
+#include <thread>
+#include <utility>
+
+#include <engine/events/event_channel.hpp>
+
+namespace game_engine
+{
+
+#pragma region EventChannel
+
+EventChannel::EventChannel(const EventChannelSettings& settings)
+    : m_policy(settings.overflow_policy)
+    , m_mask(std::bit_ceil(std::max<std::size_t>(settings.capacity, 2)) - 1)
+    , m_cells(std::make_unique<Cell[]>(m_mask + 1))
+{
+    for (std::size_t i = 0; i <= m_mask; ++i) {
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+EventChannel::~EventChannel() = default;
+
+void EventChannel::Post(Delivery delivery)
+{
+    m_posted.fetch_add(1, std::memory_order_relaxed);
+
+    // Keep posting order: once the ring overflowed, everything goes to the overflow list until it is drained
+    if (m_policy == OverflowPolicy::Grow && m_has_overflow.load(std::memory_order_acquire)) {
+        PushOverflow(std::move(delivery));
+        return;
+    }
+
+    constexpr int MaxSpins = 64;
+    for (int spins = 0; !TryPush(delivery); ++spins) {
+        switch (m_policy) {
+            case OverflowPolicy::Block: {
+                const std::size_t dequeue_position = m_dequeue_position.load(std::memory_order_relaxed);
+                if (spins < MaxSpins) {
+                    std::this_thread::yield();
+                    break;
+                }
+
+                // Sleep until the consumer moves the read position, the consumer wakes us only if someone waits
+                m_waiting_producers.fetch_add(1, std::memory_order_seq_cst);
+                m_dequeue_position.wait(dequeue_position, std::memory_order_seq_cst);
+                m_waiting_producers.fetch_sub(1, std::memory_order_relaxed);
+                break;
+            }
+            case OverflowPolicy::DropOldest: {
+                Delivery oldest;
+                if (TryPop(oldest)) {
+                    m_dropped.fetch_add(1, std::memory_order_relaxed);
+                }
+                break;
+            }
+            case OverflowPolicy::Grow: {
+                PushOverflow(std::move(delivery));
+                return;
+            }
+        }
+    }
+}
+
+std::size_t EventChannel::Drain(EventSystem& event_system)
+{
+    std::size_t delivered = 0;
+
+    bool ring_empty = false;
+
+    Delivery delivery;
+    while (delivered <= m_mask) {
+        if (!TryPop(delivery)) {
+            ring_empty = true;
+            break;
+        }
+
+        // Free the cell before running the handlers, they may post again
+        const Delivery current = std::move(delivery);
+        ++delivered;
+        m_delivered.fetch_add(1, std::memory_order_relaxed);
+        current(event_system);
+    }
+
+    if (!ring_empty) {
+        ring_empty = m_dequeue_position.load(std::memory_order_relaxed) == m_enqueue_position.load(std::memory_order_relaxed);
+    }
+
+    if (delivered != 0 && m_policy == OverflowPolicy::Block) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_waiting_producers.load(std::memory_order_relaxed) != 0) {
+            m_dequeue_position.notify_all();
+        }
+    }
+
+    // Overflowed deliveries are newer than everything in the ring, keep them until the ring is empty
+    if (ring_empty && m_policy == OverflowPolicy::Grow && m_has_overflow.load(std::memory_order_acquire)) {
+        std::vector<Delivery> overflow;
+        {
+            std::lock_guard lock(m_overflow_mutex);
+            overflow.swap(m_overflow);
+            m_has_overflow.store(false, std::memory_order_release);
+        }
+
+        for (const auto& current : overflow) {
+            ++delivered;
+            m_delivered.fetch_add(1, std::memory_order_relaxed);
+            current(event_system);
+        }
+
+        // Hand the buffer back to keep its capacity
+        overflow.clear();
+        std::lock_guard lock(m_overflow_mutex);
+        if (m_overflow.empty()) {
+            m_overflow.swap(overflow);
+        }
+    }
+
+    return delivered;
+}
+
+EventChannelStats EventChannel::GetStats() const noexcept
+{
+    EventChannelStats stats;
+    stats.posted     = m_posted.load(std::memory_order_relaxed);
+    stats.delivered  = m_delivered.load(std::memory_order_relaxed);
+    stats.dropped    = m_dropped.load(std::memory_order_relaxed);
+    stats.overflowed = m_overflowed.load(std::memory_order_relaxed);
+
+    // Counters are read one by one, so the difference is approximate while producers are posting
+    const std::uint64_t done = stats.delivered + stats.dropped;
+    stats.queued             = stats.posted > done ? stats.posted - done : 0;
+
+    return stats;
+}
+
+bool EventChannel::TryPush(Delivery& delivery)
+{
+    std::size_t position = m_enqueue_position.load(std::memory_order_relaxed);
+
+    for (;;) {
+        Cell& cell                 = m_cells[position & m_mask];
+        const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        const auto difference      = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+        if (difference == 0) {
+            if (m_enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                cell.delivery = std::move(delivery);
+                cell.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (difference < 0) {
+            return false; // Full
+        } else {
+            position = m_enqueue_position.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool EventChannel::TryPop(Delivery& delivery)
+{
+    std::size_t position = m_dequeue_position.load(std::memory_order_relaxed);
+
+    for (;;) {
+        Cell& cell                 = m_cells[position & m_mask];
+        const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        const auto difference      = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+
+        if (difference == 0) {
+            if (m_dequeue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                delivery = std::move(cell.delivery);
+                cell.sequence.store(position + m_mask + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (difference < 0) {
+            return false; // Empty
+        } else {
+            position = m_dequeue_position.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void EventChannel::PushOverflow(Delivery&& delivery)
+{
+    std::lock_guard lock(m_overflow_mutex);
+    m_overflow.push_back(std::move(delivery));
+    m_has_overflow.store(true, std::memory_order_release);
+    m_overflowed.fetch_add(1, std::memory_order_relaxed);
+}
+
+#pragma endregion
+
+} // namespace game_engine
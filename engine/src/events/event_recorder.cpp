@@ -0,0 +1,123 @@
+#include "event_recorder.hpp"
+
+#define LOG_ERROR std::cerr
+#include <iostream>
+
+namespace game_engine
+{
+
+EventRecorder::EventRecorder() = default;
+
+EventRecorder::~EventRecorder()
+{
+    Close();
+}
+
+#pragma region IBackendObserver
+
+void EventRecorder::OnEvent(const KeyboardInputEvent& event)
+{
+    Write(backend::MakeEventRecord(event));
+}
+
+void EventRecorder::OnEvent(const WindowResizeEvent& event)
+{
+    Write(backend::MakeEventRecord(event));
+}
+
+void EventRecorder::OnEvent(const WindowMoveEvent& event)
+{
+    Write(backend::MakeEventRecord(event));
+}
+
+void EventRecorder::OnEvent(const WindowCloseEvent& event)
+{
+    Write(backend::MakeEventRecord(event));
+}
+
+void EventRecorder::OnEvent(const WindowFocusEvent& event)
+{
+    Write(backend::MakeEventRecord(event));
+}
+
+void EventRecorder::OnEvent(const WindowIconifyEvent& event)
+{
+    Write(backend::MakeEventRecord(event));
+}
+
+void EventRecorder::OnEvent(const WindowMaximizeEvent& event)
+{
+    Write(backend::MakeEventRecord(event));
+}
+
+#pragma endregion
+
+#pragma region EventRecorder methods
+
+bool EventRecorder::Open(const std::filesystem::path& file)
+{
+    Close();
+
+    m_stream.open(file, std::ios::binary | std::ios::trunc);
+    if (!m_stream) {
+        LOG_ERROR << "Failed to open event recording file: " << file << std::endl;
+        return false;
+    }
+
+    backend::WriteEventRecordHeader(m_stream);
+
+    m_start_time    = std::chrono::steady_clock::now();
+    m_frame         = 0;
+    m_frame_started = false;
+    m_records_count = 0;
+
+    return true;
+}
+
+void EventRecorder::Close()
+{
+    if (m_stream.is_open()) {
+        m_stream.close();
+    }
+}
+
+bool EventRecorder::IsOpen() const noexcept
+{
+    return m_stream.is_open();
+}
+
+void EventRecorder::NextFrame() noexcept
+{
+    if (m_frame_started) {
+        ++m_frame;
+    }
+    m_frame_started = true;
+}
+
+std::uint64_t EventRecorder::GetRecordsCount() const noexcept
+{
+    return m_records_count;
+}
+
+#pragma endregion
+
+#pragma region Private helpers
+
+void EventRecorder::Write(backend::EventRecord record)
+{
+    if (!m_stream.is_open()) {
+        return;
+    }
+
+    const auto elapsed = std::chrono::steady_clock::now() - m_start_time;
+
+    record.timestamp = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    record.frame     = m_frame;
+
+    backend::WriteEventRecord(m_stream, record);
+    ++m_records_count;
+}
+
+#pragma endregion
+
+} // namespace game_engine
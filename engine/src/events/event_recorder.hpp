@@ -0,0 +1,66 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+
+#include <modules/backend/event_record.hpp>
+#include <modules/input_handler.hpp>
+
+namespace game_engine
+{
+
+/// @brief Writes every backend event it observes to a binary file, see modules/backend/event_record.hpp.
+/// Records carry the time since Open and the index of the frame, advanced with NextFrame before each PollEvents.
+class EventRecorder final : public IBackendObserver
+{
+public:
+
+    EventRecorder();
+    ~EventRecorder() override;
+
+    EventRecorder(const EventRecorder&) = delete;
+    EventRecorder(EventRecorder&&)      = delete;
+
+    EventRecorder& operator=(const EventRecorder&) = delete;
+    EventRecorder& operator=(EventRecorder&&)      = delete;
+
+    // IBackendObserver
+    void OnEvent(const KeyboardInputEvent& event) override;
+    void OnEvent(const WindowResizeEvent& event) override;
+    void OnEvent(const WindowMoveEvent& event) override;
+    void OnEvent(const WindowCloseEvent& event) override;
+    void OnEvent(const WindowFocusEvent& event) override;
+    void OnEvent(const WindowIconifyEvent& event) override;
+    void OnEvent(const WindowMaximizeEvent& event) override;
+
+    // EventRecorder methods
+
+    /// @brief Starts a new recording, replacing the file.
+    /// @return False if the file can't be written.
+    bool Open(const std::filesystem::path& file);
+
+    /// @brief Flushes and closes the file.
+    void Close();
+
+    bool IsOpen() const noexcept;
+
+    /// @brief Starts the next frame. Call once before every PollEvents, the first call starts frame 0.
+    void NextFrame() noexcept;
+
+    /// @brief Number of events written since Open.
+    std::uint64_t GetRecordsCount() const noexcept;
+
+private:
+
+    void Write(backend::EventRecord record);
+
+    std::ofstream m_stream;
+    std::chrono::steady_clock::time_point m_start_time;
+    std::uint32_t m_frame         = 0;
+    bool m_frame_started          = false;
+    std::uint64_t m_records_count = 0;
+};
+
+} // namespace game_engine
@@ -1,3 +1,5 @@
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
 #include <engine/events/event_system.hpp>
@@ -20,12 +22,20 @@ std::strong_ordering operator<=>(HandlerPriority a, HandlerPriority b) noexcept
 
 #pragma region EventSystem
 
+EventSystem::EventSystem()
+    : EventSystem(EventChannelSettings{})
+{}
+
+EventSystem::EventSystem(const EventChannelSettings& channel_settings)
+    : m_channel(channel_settings)
+{}
+
 EventSystem::~EventSystem()
 {
     std::vector<std::string> leakedEvents;
     {
         std::lock_guard lock(m_mutex);
-        for (const auto& [type, dispatcher] : m_dispatchers) {
+        for (const auto& dispatcher : m_dispatchers) {
             if (dispatcher->HasHandlers()) {
                 leakedEvents.push_back(dispatcher->GetEventTypeName());
             }
@@ -40,6 +50,95 @@ EventSystem::~EventSystem()
     }
 }
 
+EventSystem::Subscription EventSystem::SubscribeKey(KeyCode code,
+    KeyAction action,
+    Handler<KeyboardInputEvent> handler,
+    HandlerPriority priority,
+    DeliveryMode mode)
+{
+    return SubscribeKeyed<KeyboardInputEvent>({code, action}, std::move(handler), priority, mode);
+}
+
+void EventSystem::Flush()
+{
+    PROFILE_ZONE("EventSystem::Flush");
+
+    m_channel.Drain(*this);
+
+    std::vector<IDispatcherBase*> dispatchers;
+    {
+        std::lock_guard lock(m_queue_mutex);
+        std::swap(dispatchers, m_queued_dispatchers);
+    }
+
+    for (const auto& dispatcher : dispatchers) {
+        dispatcher->Flush();
+    }
+
+    // Hand the buffer back to keep its capacity
+    dispatchers.clear();
+    std::lock_guard lock(m_queue_mutex);
+    if (m_queued_dispatchers.empty()) {
+        std::swap(dispatchers, m_queued_dispatchers);
+    }
+}
+
+EventChannelStats EventSystem::GetChannelStats() const noexcept
+{
+    return m_channel.GetStats();
+}
+
+EventSystem::EventTypeId EventSystem::NextEventTypeId()
+{
+    static std::atomic<EventTypeId> s_next_id{0};
+
+    const EventTypeId id = s_next_id.fetch_add(1, std::memory_order_relaxed);
+    if (id >= MaxEventTypes) {
+        throw std::length_error("Too many event types, increase EventSystem::MaxEventTypes");
+    }
+
+    return id;
+}
+
+#pragma endregion
+
+#pragma region EventSystem::Subscription
+
+EventSystem::Subscription::Subscription(std::weak_ptr<IDispatcherBase> dispatcher, HandlerHandle handle) noexcept
+    : m_dispatcher(std::move(dispatcher))
+    , m_handle(handle)
+{}
+
+EventSystem::Subscription::~Subscription()
+{
+    Unsubscribe();
+}
+
+EventSystem::Subscription::Subscription(Subscription&& other) noexcept
+    : m_dispatcher(std::move(other.m_dispatcher))
+    , m_handle(std::exchange(other.m_handle, {}))
+{}
+
+EventSystem::Subscription& EventSystem::Subscription::operator=(Subscription&& other) noexcept
+{
+    if (this != &other) {
+        Unsubscribe();
+        m_dispatcher = std::move(other.m_dispatcher);
+        m_handle     = std::exchange(other.m_handle, {});
+    }
+    return *this;
+}
+
+void EventSystem::Subscription::Unsubscribe()
+{
+    if (auto dispatcher = m_dispatcher.lock()) {
+        dispatcher->Unsubscribe(m_handle);
+    }
+
+    m_dispatcher.reset();
+    m_handle = {};
+}
+
 #pragma endregion
 
 } // namespace game_engine
@@ -0,0 +1,58 @@
+#include "frame_pacer.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace game_engine
+{
+
+FramePacer::FramePacer(FramePacing pacing, std::chrono::nanoseconds spin_threshold) noexcept
+    : m_pacing(pacing)
+    , m_spin_threshold(spin_threshold)
+{}
+
+void FramePacer::SetPacing(FramePacing pacing) noexcept
+{
+    m_pacing = pacing;
+}
+
+void FramePacer::SetSpinThreshold(std::chrono::nanoseconds spin_threshold) noexcept
+{
+    m_spin_threshold = std::max(spin_threshold, std::chrono::nanoseconds::zero());
+}
+
+void FramePacer::WaitUntil(TimePoint deadline)
+{
+    if (Clock::now() >= deadline) {
+        return;
+    }
+
+    const auto spin_threshold = m_pacing == FramePacing::LowLatency ? m_spin_threshold : std::chrono::nanoseconds::zero();
+
+    const TimePoint sleep_deadline = deadline - spin_threshold;
+    if (Clock::now() < sleep_deadline) {
+        std::this_thread::sleep_until(sleep_deadline);
+    }
+
+    TimePoint now = Clock::now();
+    while (now < deadline) {
+        std::this_thread::yield();
+        now = Clock::now();
+    }
+
+    const auto jitter = now - deadline;
+
+    m_stats.waits++;
+    m_total_jitter += jitter;
+
+    m_stats.last_jitter    = jitter;
+    m_stats.max_jitter     = std::max(m_stats.max_jitter, jitter);
+    m_stats.average_jitter = m_total_jitter / static_cast<std::int64_t>(m_stats.waits);
+}
+
+const FramePacer::Stats& FramePacer::GetStats() const noexcept
+{
+    return m_stats;
+}
+
+} // namespace game_engine
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include <engine/game_settings.hpp>
+
+namespace game_engine
+{
+
+/// @brief Waits for main loop deadlines without burning a core.
+/// Sleeps with the OS timer and, with FramePacing::LowLatency, spins the last part of the wait to wake up on time.
+class FramePacer final
+{
+public:
+
+    using Clock     = std::chrono::steady_clock;
+    using TimePoint = std::chrono::time_point<Clock, std::chrono::nanoseconds>;
+
+    /// @brief Lateness of wake-ups, measured against the requested deadlines.
+    struct Stats
+    {
+        std::chrono::nanoseconds last_jitter{};    ///< Lateness of the last wait.
+        std::chrono::nanoseconds average_jitter{}; ///< Mean lateness of all waits.
+        std::chrono::nanoseconds max_jitter{};     ///< Largest lateness of all waits.
+        std::uint64_t waits = 0;                   ///< Number of waits that had to sleep or spin.
+    };
+
+    FramePacer() = default;
+    FramePacer(FramePacing pacing, std::chrono::nanoseconds spin_threshold) noexcept;
+
+    void SetPacing(FramePacing pacing) noexcept;
+    void SetSpinThreshold(std::chrono::nanoseconds spin_threshold) noexcept;
+
+    /// @brief Blocks until the deadline. Returns at once if it has already passed.
+    void WaitUntil(TimePoint deadline);
+
+    const Stats& GetStats() const noexcept;
+
+private:
+
+    FramePacing m_pacing = FramePacing::LowLatency;
+    std::chrono::nanoseconds m_spin_threshold{std::chrono::microseconds(1500)};
+
+    Stats m_stats;
+    std::chrono::nanoseconds m_total_jitter{};
+};
+
+} // namespace game_engine
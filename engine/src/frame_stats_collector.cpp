@@ -0,0 +1,120 @@
+#include "frame_stats_collector.hpp"
+
+#include <algorithm>
+
+namespace game_engine
+{
+
+#pragma region FrameStatsCollector::ScopedTimer
+
+FrameStatsCollector::ScopedTimer::ScopedTimer(FrameStatsCollector& collector, FramePhase phase) noexcept
+    : m_collector(collector)
+    , m_phase(phase)
+    , m_start(Clock::now())
+{}
+
+FrameStatsCollector::ScopedTimer::~ScopedTimer()
+{
+    m_collector.Record(m_phase, Clock::now() - m_start);
+}
+
+#pragma endregion
+
+#pragma region FrameStatsCollector
+
+void FrameStatsCollector::Record(FramePhase phase, std::chrono::nanoseconds duration) noexcept
+{
+    m_histograms[static_cast<std::size_t>(phase)].Record(duration);
+}
+
+void FrameStatsCollector::RecordFramesInFlight(std::size_t frames) noexcept
+{
+    m_frames_in_flight.store(frames, std::memory_order_relaxed);
+
+    // Only the main thread records, a plain compare is enough
+    if (frames > m_max_frames_in_flight.load(std::memory_order_relaxed)) {
+        m_max_frames_in_flight.store(frames, std::memory_order_relaxed);
+    }
+}
+
+void FrameStatsCollector::RecordSkippedFrame() noexcept
+{
+    m_skipped_frames.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FrameStatsCollector::RecordDrawCalls(std::size_t draw_calls) noexcept
+{
+    m_draw_calls.store(draw_calls, std::memory_order_relaxed);
+}
+
+void FrameStatsCollector::RecordStateChanges(std::uint64_t issued, std::uint64_t skipped) noexcept
+{
+    m_state_changes.store(issued, std::memory_order_relaxed);
+    m_skipped_state_changes.store(skipped, std::memory_order_relaxed);
+}
+
+void FrameStatsCollector::RecordQueueLatency(RenderLane lane, std::chrono::nanoseconds latency) noexcept
+{
+    m_queue_latency[static_cast<std::size_t>(lane)].Record(latency);
+}
+
+void FrameStatsCollector::Rotate(std::size_t updates_per_second, std::size_t frames_per_second) noexcept
+{
+    for (auto& histogram : m_histograms) {
+        histogram.Rotate();
+    }
+
+    for (auto& histogram : m_queue_latency) {
+        histogram.Rotate();
+    }
+
+    m_prev_max_frames_in_flight.store(m_max_frames_in_flight.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+
+    m_updates_per_second.store(updates_per_second, std::memory_order_relaxed);
+    m_frames_per_second.store(frames_per_second, std::memory_order_relaxed);
+}
+
+void FrameStatsCollector::Reset() noexcept
+{
+    for (auto& histogram : m_histograms) {
+        histogram.Reset();
+    }
+
+    for (auto& histogram : m_queue_latency) {
+        histogram.Reset();
+    }
+
+    m_max_frames_in_flight.store(0, std::memory_order_relaxed);
+    m_prev_max_frames_in_flight.store(0, std::memory_order_relaxed);
+    m_skipped_frames.store(0, std::memory_order_relaxed);
+}
+
+FrameStats FrameStatsCollector::GetStats() const noexcept
+{
+    FrameStats stats;
+    for (std::size_t i = 0; i < FramePhaseCount; ++i) {
+        stats.phases[i] = m_histograms[i].GetTimings();
+    }
+
+    for (std::size_t i = 0; i < RenderLaneCount; ++i) {
+        stats.queue_latency[i] = m_queue_latency[i].GetTimings();
+    }
+
+    stats.updates_per_second = m_updates_per_second.load(std::memory_order_relaxed);
+    stats.frames_per_second  = m_frames_per_second.load(std::memory_order_relaxed);
+
+    stats.frames_in_flight     = m_frames_in_flight.load(std::memory_order_relaxed);
+    stats.max_frames_in_flight = std::max(m_max_frames_in_flight.load(std::memory_order_relaxed),
+                                          m_prev_max_frames_in_flight.load(std::memory_order_relaxed));
+    stats.skipped_frames       = m_skipped_frames.load(std::memory_order_relaxed);
+    stats.draw_calls           = m_draw_calls.load(std::memory_order_relaxed);
+
+    stats.state_changes         = m_state_changes.load(std::memory_order_relaxed);
+    stats.skipped_state_changes = m_skipped_state_changes.load(std::memory_order_relaxed);
+
+    return stats;
+}
+
+#pragma endregion
+
+} // namespace game_engine
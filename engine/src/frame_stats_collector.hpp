@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <engine/frame_stats.hpp>
+
+#include <latency_histogram.hpp>
+
+namespace game_engine
+{
+
+/// @brief Collects per-phase frame timings from the main, simulation and render threads.
+/// Recording is lock-free and doesn't allocate, so it can stay enabled in release builds.
+class FrameStatsCollector final
+{
+public:
+
+    using Clock = std::chrono::steady_clock;
+
+    /// @brief Records the time from construction to destruction as one sample of a phase.
+    class ScopedTimer final
+    {
+    public:
+
+        ScopedTimer(FrameStatsCollector& collector, FramePhase phase) noexcept;
+        ~ScopedTimer();
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer(ScopedTimer&&)      = delete;
+
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(ScopedTimer&&)      = delete;
+
+    private:
+
+        FrameStatsCollector& m_collector;
+        FramePhase m_phase;
+        Clock::time_point m_start;
+    };
+
+    FrameStatsCollector() = default;
+
+    FrameStatsCollector(const FrameStatsCollector&) = delete;
+    FrameStatsCollector(FrameStatsCollector&&)      = delete;
+
+    FrameStatsCollector& operator=(const FrameStatsCollector&) = delete;
+    FrameStatsCollector& operator=(FrameStatsCollector&&)      = delete;
+
+    void Record(FramePhase phase, std::chrono::nanoseconds duration) noexcept;
+
+    /// @brief Records the render queue depth, called by the renderer for every submitted or skipped frame.
+    void RecordFramesInFlight(std::size_t frames) noexcept;
+
+    void RecordSkippedFrame() noexcept;
+
+    /// @brief Records the draw calls of a rendered frame, called by the render thread.
+    void RecordDrawCalls(std::size_t draw_calls) noexcept;
+
+    /// @brief Records the issued and skipped state changes of a rendered frame, called by the render thread.
+    void RecordStateChanges(std::uint64_t issued, std::uint64_t skipped) noexcept;
+
+    /// @brief Records the time a render thread task waited in its lane before it ran.
+    void RecordQueueLatency(RenderLane lane, std::chrono::nanoseconds latency) noexcept;
+
+    /// @brief Starts a new window of samples and publishes the rates counted over the last second.
+    /// Called by the main loop once per second.
+    void Rotate(std::size_t updates_per_second, std::size_t frames_per_second) noexcept;
+
+    /// @brief Drops all samples, e.g. after a warmup.
+    void Reset() noexcept;
+
+    FrameStats GetStats() const noexcept;
+
+private:
+
+    std::array<LatencyHistogram, FramePhaseCount> m_histograms;
+    std::array<LatencyHistogram, RenderLaneCount> m_queue_latency;
+
+    std::atomic<std::size_t> m_updates_per_second = 0;
+    std::atomic<std::size_t> m_frames_per_second  = 0;
+
+    std::atomic<std::size_t> m_frames_in_flight          = 0;
+    std::atomic<std::size_t> m_max_frames_in_flight      = 0; ///< Since the last rotation.
+    std::atomic<std::size_t> m_prev_max_frames_in_flight = 0; ///< Between the last two rotations.
+    std::atomic<std::uint64_t> m_skipped_frames          = 0;
+    std::atomic<std::size_t> m_draw_calls                = 0;
+    std::atomic<std::uint64_t> m_state_changes           = 0;
+    std::atomic<std::uint64_t> m_skipped_state_changes   = 0;
+};
+
+} // namespace game_engine
@@ -0,0 +1,26 @@
+#include "frame_fence.hpp"
+
+namespace game_engine
+{
+
+void FrameFence::Signal(std::uint64_t frame) noexcept
+{
+    m_completed.store(frame, std::memory_order_release);
+    m_completed.notify_all();
+}
+
+void FrameFence::Wait(std::uint64_t frame) const noexcept
+{
+    std::uint64_t completed = m_completed.load(std::memory_order_acquire);
+    while (completed < frame) {
+        m_completed.wait(completed, std::memory_order_acquire);
+        completed = m_completed.load(std::memory_order_acquire);
+    }
+}
+
+std::uint64_t FrameFence::GetCompletedFrame() const noexcept
+{
+    return m_completed.load(std::memory_order_acquire);
+}
+
+} // namespace game_engine
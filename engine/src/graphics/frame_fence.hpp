@@ -0,0 +1,37 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace game_engine
+{
+
+/// @brief Tracks which frames the render thread has finished.
+/// Frames are numbered from 1 in submission order, the render thread signals each one after presenting it.
+class FrameFence final
+{
+public:
+
+    FrameFence() = default;
+
+    FrameFence(const FrameFence&) = delete;
+    FrameFence(FrameFence&&)      = delete;
+
+    FrameFence& operator=(const FrameFence&) = delete;
+    FrameFence& operator=(FrameFence&&)      = delete;
+
+    /// @brief Marks the frame and all frames before it as completed.
+    void Signal(std::uint64_t frame) noexcept;
+
+    /// @brief Blocks until the frame is completed.
+    void Wait(std::uint64_t frame) const noexcept;
+
+    /// @brief Returns the number of the last completed frame, 0 if there is none.
+    std::uint64_t GetCompletedFrame() const noexcept;
+
+private:
+
+    std::atomic<std::uint64_t> m_completed = 0;
+};
+
+} // namespace game_engine
@@ -0,0 +1,104 @@
+#include "instance_batcher.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace game_engine
+{
+
+InstanceBatcher::InstanceBatcher()
+    : m_transform_id(graphics::InstanceTransformProperty)
+{}
+
+std::span<const std::uint32_t> InstanceBatcher::Batch(std::vector<graphics::RenderCommand>& commands,
+                                                      graphics::PropertyBuffer& properties,
+                                                      std::span<const std::uint32_t> order)
+{
+    m_draws.clear();
+    m_transforms.clear();
+
+    std::size_t begin = 0;
+    while (begin < order.size()) {
+        auto& first     = commands[order[begin]];
+        std::size_t end = begin + 1;
+
+        if (first.instance_count == 1 && FindInstanceTransform(properties, first) != nullptr) {
+            while (end < order.size() && CanMerge(properties, first, commands[order[end]])) {
+                ++end;
+            }
+        }
+
+        if (end - begin >= MinInstances) {
+            first.first_instance = static_cast<std::uint32_t>(m_transforms.size());
+            first.instance_count = static_cast<std::uint32_t>(end - begin);
+
+            for (std::size_t i = begin; i < end; ++i) {
+                const auto* transform = FindInstanceTransform(properties, commands[order[i]]);
+                m_transforms.push_back(properties.GetValue<Matrix4>(*transform));
+            }
+
+            // Uniform order doesn't matter, move the transform to the end of the range and drop it
+            auto packed = properties.Get(first.properties);
+            std::swap(*std::ranges::find_if(packed, [this](const auto& p) { return IsInstanceTransform(p); }), packed.back());
+            --first.properties.count;
+        }
+
+        m_draws.push_back(order[begin]);
+        begin = end;
+    }
+
+    return m_draws;
+}
+
+std::span<const Matrix4> InstanceBatcher::GetInstanceTransforms() const noexcept
+{
+    return m_transforms;
+}
+
+const graphics::PackedProperty* InstanceBatcher::FindInstanceTransform(const graphics::PropertyBuffer& properties,
+                                                                       const graphics::RenderCommand& command) const noexcept
+{
+    const auto packed = properties.Get(command.properties);
+    const auto it     = std::ranges::find_if(packed, [this](const auto& p) { return IsInstanceTransform(p); });
+    return it != packed.end() ? &*it : nullptr;
+}
+
+bool InstanceBatcher::CanMerge(const graphics::PropertyBuffer& properties,
+                               const graphics::RenderCommand& first,
+                               const graphics::RenderCommand& other) const noexcept
+{
+    if (other.instance_count != 1 || other.mesh != first.mesh || other.shader != first.shader ||
+        other.properties.count != first.properties.count) {
+        return false;
+    }
+
+    const auto lhs = properties.Get(first.properties);
+    const auto rhs = properties.Get(other.properties);
+
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+        if (lhs[i].id != rhs[i].id || lhs[i].type != rhs[i].type) {
+            return false;
+        }
+
+        if (IsInstanceTransform(lhs[i])) {
+            continue;
+        }
+
+        // Packed values have no padding, equal bytes are equal values
+        const auto lhs_data = properties.GetData(lhs[i]);
+        const auto rhs_data = properties.GetData(rhs[i]);
+        if (std::memcmp(lhs_data.data(), rhs_data.data(), lhs_data.size()) != 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool InstanceBatcher::IsInstanceTransform(const graphics::PackedProperty& property) const noexcept
+{
+    return property.id == m_transform_id && property.type == graphics::PropertyType::Matrix4;
+}
+
+} // namespace game_engine
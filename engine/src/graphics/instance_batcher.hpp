@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <engine/common_types.hpp>
+#include <engine/graphics/property.hpp>
+
+#include <modules/graphics/property_buffer.hpp>
+#include <modules/graphics/render_command.hpp>
+
+namespace game_engine
+{
+
+/// @brief Merges consecutive draws of the same mesh and shader into instanced commands.
+/// Draws are merged if all their properties but graphics::InstanceTransformProperty are equal, the transforms are
+/// packed into a per-frame buffer. Keeps its buffers between frames, like RenderCommandSorter.
+class InstanceBatcher final
+{
+public:
+
+    static constexpr std::size_t MinInstances = 2; ///< Shorter runs stay single draws.
+
+    InstanceBatcher();
+
+    InstanceBatcher(const InstanceBatcher&) = delete;
+    InstanceBatcher(InstanceBatcher&&)      = delete;
+
+    InstanceBatcher& operator=(const InstanceBatcher&) = delete;
+    InstanceBatcher& operator=(InstanceBatcher&&)      = delete;
+
+    /// @brief Merges runs of commands in the given order. The first command of a run becomes the instanced one,
+    /// its transform property is moved out of its range, and the other commands of the run are left out of the result.
+    /// @param commands      The frame's commands, merged commands are modified in place.
+    /// @param properties    The frame's properties, the properties of merged commands are reordered.
+    /// @param order         Execution order of the commands, see RenderCommandSorter.
+    /// @return Indices of the commands to execute, valid until the next call.
+    std::span<const std::uint32_t> Batch(std::vector<graphics::RenderCommand>& commands,
+                                         graphics::PropertyBuffer& properties,
+                                         std::span<const std::uint32_t> order);
+
+    /// @brief Returns the transforms of the instanced commands of the last Batch call.
+    std::span<const Matrix4> GetInstanceTransforms() const noexcept;
+
+private:
+
+    /// @brief Returns the command's transform property, null if it has none.
+    const graphics::PackedProperty* FindInstanceTransform(const graphics::PropertyBuffer& properties,
+                                                          const graphics::RenderCommand& command) const noexcept;
+
+    bool CanMerge(const graphics::PropertyBuffer& properties,
+                  const graphics::RenderCommand& first,
+                  const graphics::RenderCommand& other) const noexcept;
+
+    bool IsInstanceTransform(const graphics::PackedProperty& property) const noexcept;
+
+    const PropertyId m_transform_id;
+
+    std::vector<std::uint32_t> m_draws;
+    std::vector<Matrix4> m_transforms;
+};
+
+} // namespace game_engine
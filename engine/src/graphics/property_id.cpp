@@ -0,0 +1,56 @@
+#include <deque>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+#include <engine/graphics/property.hpp>
+
+namespace
+{
+
+/// @brief Owns the interned names, their addresses never change.
+class PropertyNames final
+{
+public:
+
+    std::pair<std::uint32_t, const char*> Intern(std::string_view name)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (const auto it = m_indices.find(name); it != m_indices.end()) {
+            return {it->second, it->first.data()};
+        }
+
+        const auto& stored = m_names.emplace_back(name);
+        const auto index   = static_cast<std::uint32_t>(m_names.size());
+        m_indices.emplace(stored, index);
+
+        return {index, stored.c_str()};
+    }
+
+private:
+
+    std::mutex m_mutex;
+    std::deque<std::string> m_names;
+    std::unordered_map<std::string_view, std::uint32_t> m_indices; ///< Views into m_names.
+};
+
+PropertyNames& GetPropertyNames()
+{
+    static PropertyNames s_names;
+    return s_names;
+}
+
+} // namespace
+
+namespace game_engine
+{
+
+PropertyId::PropertyId(std::string_view name)
+{
+    std::tie(m_index, m_name) = GetPropertyNames().Intern(name);
+}
+
+} // namespace game_engine
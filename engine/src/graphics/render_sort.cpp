@@ -0,0 +1,109 @@
+#include "render_sort.hpp"
+
+#include <array>
+#include <bit>
+#include <utility>
+
+namespace
+{
+
+constexpr int PassShift             = 62;
+constexpr int TransparentDepthShift = 46;
+constexpr int ShaderShift           = 36;
+constexpr int MeshShift             = 16;
+
+constexpr int IndexBits = game_engine::graphics::RenderHandle::IndexBits;
+
+// Both indices fit their fields, also when shifted down below the transparent depth
+static_assert(MeshShift + IndexBits <= ShaderShift && ShaderShift + IndexBits - MeshShift <= TransparentDepthShift);
+
+constexpr std::size_t RadixBits   = 8;
+constexpr std::size_t RadixSize   = 1 << RadixBits;
+constexpr std::size_t RadixPasses = 64 / RadixBits;
+
+/// @brief Quantizes a depth to 16 bits. The bits of positive floats order like the floats, the top 16 keep
+/// the exponent and 7 bits of mantissa.
+std::uint64_t QuantizeDepth(float depth) noexcept
+{
+    if (!(depth > 0.0f)) {
+        return 0;
+    }
+
+    return std::bit_cast<std::uint32_t>(depth) >> 16;
+}
+
+} // namespace
+
+namespace game_engine
+{
+
+std::uint64_t MakeSortKey(const DrawOrder& order,
+                          graphics::RenderHandle shader,
+                          graphics::RenderHandle mesh,
+                          TransparentSorting transparent_sorting) noexcept
+{
+    const std::uint64_t pass  = static_cast<std::uint64_t>(order.pass) << PassShift;
+    const std::uint64_t depth = QuantizeDepth(order.depth);
+
+    const std::uint64_t state = (std::uint64_t{shader.GetIndex()} << ShaderShift) | (std::uint64_t{mesh.GetIndex()} << MeshShift);
+
+    if (order.pass != RenderPass::Transparent) {
+        return pass | state | depth;
+    }
+
+    if (transparent_sorting == TransparentSorting::SubmissionOrder) {
+        return pass;
+    }
+
+    // Farthest first, draws at the same depth are still grouped by state
+    return pass | ((~depth & 0xFFFF) << TransparentDepthShift) | (state >> 16);
+}
+
+std::span<const std::uint32_t> RenderCommandSorter::Sort(const std::vector<graphics::RenderCommand>& commands)
+{
+    const std::size_t count = commands.size();
+
+    m_entries.resize(count);
+    m_scratch.resize(count);
+    m_order.resize(count);
+
+    // Histograms of all digits in one pass over the keys
+    std::array<std::array<std::uint32_t, RadixSize>, RadixPasses> histograms{};
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::uint64_t key = commands[i].sort_key;
+        m_entries[i]            = {.key = key, .index = static_cast<std::uint32_t>(i)};
+
+        for (std::size_t pass = 0; pass < RadixPasses; ++pass) {
+            ++histograms[pass][(key >> (pass * RadixBits)) & (RadixSize - 1)];
+        }
+    }
+
+    for (std::size_t pass = 0; pass < RadixPasses && count != 0; ++pass) {
+        const std::size_t shift = pass * RadixBits;
+        auto& histogram         = histograms[pass];
+
+        // Skip digits all keys share, most of the high bits are usually the same
+        if (histogram[(m_entries[0].key >> shift) & (RadixSize - 1)] == count) {
+            continue;
+        }
+
+        std::uint32_t offset = 0;
+        for (auto& bucket : histogram) {
+            offset += std::exchange(bucket, offset);
+        }
+
+        for (const Entry& entry : m_entries) {
+            m_scratch[histogram[(entry.key >> shift) & (RadixSize - 1)]++] = entry;
+        }
+
+        std::swap(m_entries, m_scratch);
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+        m_order[i] = m_entries[i].index;
+    }
+
+    return m_order;
+}
+
+} // namespace game_engine
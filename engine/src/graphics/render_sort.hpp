@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <engine/game_settings.hpp>
+#include <engine/graphics/renderer.hpp>
+
+#include <modules/graphics/render_command.hpp>
+
+namespace game_engine
+{
+
+/// @brief Builds the 64-bit key the frame's commands are sorted by.
+/// From the highest bits: pass (2), unused (6), shader (20), mesh (20) and depth (16) for opaque draws, so draws
+/// sharing a shader, then a mesh run together, front to back. Shader and mesh are the slot indices of their handles,
+/// which are unique among the loaded resources and fit their fields, so different resources never share a key.
+/// Transparent draws put the inverted depth right after the pass with TransparentSorting::BackToFront, and
+/// leave all other bits zero with TransparentSorting::SubmissionOrder, the stable sort keeps their order then.
+std::uint64_t MakeSortKey(const DrawOrder& order,
+                          graphics::RenderHandle shader,
+                          graphics::RenderHandle mesh,
+                          TransparentSorting transparent_sorting) noexcept;
+
+/// @brief Orders render commands by their sort keys with a stable LSD radix sort.
+/// Keeps its buffers between frames, so sorting doesn't allocate once the frame size is stable.
+class RenderCommandSorter final
+{
+public:
+
+    RenderCommandSorter() = default;
+
+    RenderCommandSorter(const RenderCommandSorter&) = delete;
+    RenderCommandSorter(RenderCommandSorter&&)      = delete;
+
+    RenderCommandSorter& operator=(const RenderCommandSorter&) = delete;
+    RenderCommandSorter& operator=(RenderCommandSorter&&)      = delete;
+
+    /// @brief Returns the indices of the commands in ascending key order, equal keys keep their order.
+    /// The result is valid until the next call.
+    std::span<const std::uint32_t> Sort(const std::vector<graphics::RenderCommand>& commands);
+
+private:
+
+    struct Entry
+    {
+        std::uint64_t key;
+        std::uint32_t index;
+    };
+
+    std::vector<Entry> m_entries;
+    std::vector<Entry> m_scratch;
+    std::vector<std::uint32_t> m_order;
+};
+
+} // namespace game_engine
@@ -0,0 +1,126 @@
+#include "render_task_queue.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <thread>
+
+namespace game_engine
+{
+
+RenderTaskQueue::RenderTaskQueue(std::size_t capacity)
+    : m_mask(std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1)
+{
+    for (auto& lane : m_lanes) {
+        lane.slots = std::make_unique<Slot[]>(m_mask + 1);
+    }
+}
+
+RenderTaskQueue::~RenderTaskQueue() = default;
+
+void RenderTaskQueue::Push(RenderLane lane_id, Task task)
+{
+    Lane& lane = m_lanes[static_cast<std::size_t>(lane_id)];
+
+    const std::size_t tail = lane.tail.load(std::memory_order_relaxed);
+    if (tail - lane.cached_head > m_mask) {
+        lane.cached_head = lane.head.load(std::memory_order_acquire);
+
+        while (tail - lane.cached_head > m_mask) {
+            // Pairs with Wait: either the consumer sees the flag, or this thread sees it sleeping
+            m_producer_blocked.store(true, std::memory_order_seq_cst);
+            WakeConsumer();
+            std::this_thread::yield();
+
+            lane.cached_head = lane.head.load(std::memory_order_acquire);
+        }
+
+        m_producer_blocked.store(false, std::memory_order_relaxed);
+    }
+
+    Slot& slot     = lane.slots[tail & m_mask];
+    slot.task      = std::move(task);
+    slot.queued_at = Clock::now();
+
+    // Pairs with Wait: either the consumer sees the new tail, or this thread sees it sleeping
+    lane.tail.store(tail + 1, std::memory_order_seq_cst);
+    WakeConsumer();
+}
+
+bool RenderTaskQueue::TryPop(RenderLane last_lane, Task& task, TaskInfo& info)
+{
+    const auto last = static_cast<std::size_t>(GetLastLane(last_lane));
+    for (std::size_t i = 0; i <= last; ++i) {
+        Lane& lane = m_lanes[i];
+
+        const std::size_t head = lane.head.load(std::memory_order_relaxed);
+        if (head == lane.cached_tail) {
+            lane.cached_tail = lane.tail.load(std::memory_order_acquire);
+            if (head == lane.cached_tail) {
+                continue;
+            }
+        }
+
+        // Free the slot before the task runs, so the producer can reuse it
+        Slot& slot = lane.slots[head & m_mask];
+        task       = std::move(slot.task);
+        info       = {.lane = static_cast<RenderLane>(i), .queued_at = slot.queued_at};
+        lane.head.store(head + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    return false;
+}
+
+void RenderTaskQueue::Wait(RenderLane last_lane)
+{
+    for (int i = 0; i < WaitSpins; ++i) {
+        if (!IsEmpty(last_lane)) {
+            return;
+        }
+        std::this_thread::yield();
+    }
+
+    // The epoch is read before announcing the sleep, so a push after this point makes the wait return at once
+    const std::uint32_t epoch = m_wake_epoch.load(std::memory_order_acquire);
+    m_sleeping.store(true, std::memory_order_seq_cst);
+
+    if (IsEmpty(last_lane)) {
+        m_wake_epoch.wait(epoch, std::memory_order_acquire);
+    }
+
+    m_sleeping.store(false, std::memory_order_relaxed);
+}
+
+std::uint64_t RenderTaskQueue::GetWakeupsCount() const noexcept
+{
+    return m_wakeups.load(std::memory_order_relaxed);
+}
+
+bool RenderTaskQueue::IsEmpty(RenderLane last_lane) const noexcept
+{
+    const auto last = static_cast<std::size_t>(GetLastLane(last_lane));
+    for (std::size_t i = 0; i <= last; ++i) {
+        if (m_lanes[i].tail.load(std::memory_order_seq_cst) != m_lanes[i].head.load(std::memory_order_relaxed)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+RenderLane RenderTaskQueue::GetLastLane(RenderLane last_lane) const noexcept
+{
+    return m_producer_blocked.load(std::memory_order_seq_cst) ? static_cast<RenderLane>(RenderLaneCount - 1) : last_lane;
+}
+
+void RenderTaskQueue::WakeConsumer() noexcept
+{
+    if (m_sleeping.load(std::memory_order_seq_cst)) {
+        m_wake_epoch.fetch_add(1, std::memory_order_release);
+        m_wake_epoch.notify_one();
+        m_wakeups.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+} // namespace game_engine
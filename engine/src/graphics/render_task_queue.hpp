@@ -0,0 +1,103 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <engine/graphics/render_lane.hpp>
+#include <engine/utils/inplace_function.hpp>
+
+namespace game_engine
+{
+
+/// @brief Fixed-capacity single-producer/single-consumer rings of tasks for the render thread, one per RenderLane.
+/// Tasks are stored in place, pushing and popping never allocate or lock.
+/// The consumer sleeps on a futex (std::atomic::wait) when the lanes it waits for are empty, and the producer only
+/// issues the wake-up call when the consumer is actually sleeping.
+/// While the producer is blocked on a full lane the consumer takes tasks from every lane, so a consumer that holds
+/// back the last lanes can't stall the producer forever.
+class RenderTaskQueue final
+{
+public:
+
+    static constexpr std::size_t TaskCapacity = 128;
+
+    using Task  = InplaceFunction<void(), TaskCapacity>;
+    using Clock = std::chrono::steady_clock;
+
+    /// @brief Where a popped task came from.
+    struct TaskInfo
+    {
+        RenderLane lane = RenderLane::Frame;
+        Clock::time_point queued_at; ///< When the task was pushed.
+    };
+
+    /// @param capacity    Number of task slots per lane, rounded up to a power of two.
+    explicit RenderTaskQueue(std::size_t capacity);
+    ~RenderTaskQueue();
+
+    RenderTaskQueue(const RenderTaskQueue&) = delete;
+    RenderTaskQueue(RenderTaskQueue&&)      = delete;
+
+    RenderTaskQueue& operator=(const RenderTaskQueue&) = delete;
+    RenderTaskQueue& operator=(RenderTaskQueue&&)      = delete;
+
+    /// @brief Adds a task to the lane, yields while the lane is full. Producer thread only.
+    /// A full lane wakes the consumer and makes it pop from all lanes until the task is pushed.
+    void Push(RenderLane lane, Task task);
+
+    /// @brief Takes the oldest task of the first non-empty lane, up to the given one or up to the last lane while the
+    /// producer is blocked. Consumer thread only.
+    /// @return False if these lanes are empty.
+    bool TryPop(RenderLane last_lane, Task& task, TaskInfo& info);
+
+    /// @brief Blocks until one of the lanes up to the given one is not empty, spinning shortly before going to sleep.
+    /// Consumer thread only.
+    void Wait(RenderLane last_lane);
+
+    /// @brief Returns the number of wake-up calls the producer had to make.
+    std::uint64_t GetWakeupsCount() const noexcept;
+
+private:
+
+    static constexpr std::size_t CacheLine = 64;
+    static constexpr int WaitSpins         = 32;
+
+    struct Slot
+    {
+        Task task;
+        Clock::time_point queued_at;
+    };
+
+    struct Lane
+    {
+        std::unique_ptr<Slot[]> slots;
+
+        alignas(CacheLine) std::atomic<std::size_t> head = 0; ///< Next slot to pop, written by the consumer.
+        std::size_t cached_tail                          = 0; ///< Consumer's copy of tail.
+
+        alignas(CacheLine) std::atomic<std::size_t> tail = 0; ///< Next slot to push, written by the producer.
+        std::size_t cached_head                          = 0; ///< Producer's copy of head.
+    };
+
+    bool IsEmpty(RenderLane last_lane) const noexcept;
+
+    /// @brief Returns the last lane the consumer may pop from.
+    RenderLane GetLastLane(RenderLane last_lane) const noexcept;
+
+    /// @brief Wakes the consumer if it is sleeping. Producer thread only.
+    void WakeConsumer() noexcept;
+
+    const std::size_t m_mask;
+    std::array<Lane, RenderLaneCount> m_lanes;
+
+    alignas(CacheLine) std::atomic<bool> m_sleeping = false;
+    std::atomic<bool> m_producer_blocked           = false; ///< The producer waits for a slot in a full lane.
+    std::atomic<std::uint32_t> m_wake_epoch        = 0;     ///< Futex word the consumer sleeps on.
+    std::atomic<std::uint64_t> m_wakeups           = 0;
+};
+
+} // namespace game_engine
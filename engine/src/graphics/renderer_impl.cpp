@@ -1,23 +1,49 @@
 #include "renderer_impl.hpp"
 
+#include <algorithm>
 #include <future>
 
+#include <engine/utils/profiler.hpp>
+
 #include <modules/backend/backend_module.hpp>
 #include <modules/graphics/render_command.hpp>
 #include <modules/graphics/renderer_module.hpp>
 #include <modules/module_locator.hpp>
 
+#include <frame_stats_collector.hpp>
 #include <graphics/render_context_impl.hpp>
+#include <resource_management/resources/mesh_resource.hpp>
+#include <resource_management/resources/shader_resource.hpp>
+#include <resource_management/resources/texture_resource.hpp>
 
 #define LOG_ERROR std::cerr
 #include <iostream>
 
+namespace
+{
+
+void MarkLoadedInGPU(game_engine::IResource& resource)
+{
+    using namespace game_engine;
+
+    if (auto* mesh = dynamic_cast<MeshResource*>(&resource)) {
+        mesh->SetState(ResourceState::LoadedInGPU);
+    } else if (auto* shader = dynamic_cast<ShaderResource*>(&resource)) {
+        shader->SetState(ResourceState::LoadedInGPU);
+    } else if (auto* texture = dynamic_cast<TextureResource*>(&resource)) {
+        texture->SetState(ResourceState::LoadedInGPU);
+    }
+}
+
+} // namespace
+
 namespace game_engine
 {
 
-RendererImpl::RendererImpl(const ModuleLocator& locator)
+RendererImpl::RendererImpl(const ModuleLocator& locator, std::shared_ptr<FrameStatsCollector> frame_stats)
     : m_context(std::make_shared<RenderContextImpl>(locator.Get<backend::IBackendModule>()))
     , m_renderer_module(locator.Get<graphics::IRendererModule>())
+    , m_frame_stats(std::move(frame_stats))
 {}
 
 RendererImpl::~RendererImpl()
@@ -29,98 +55,135 @@ RendererImpl::~RendererImpl()
 
 bool RendererImpl::Load(const std::shared_ptr<IMesh>& mesh)
 {
-    if (!m_running) {
-        LOG_ERROR << "Renderer not initialized" << std::endl;
-        return false;
-    }
-
-    try {
-        auto result = SubmitWithResult<bool>([this, &mesh] { return m_renderer_module->Load(mesh); });
-        result.get();
+    return LoadResource(mesh, m_mesh_handles);
+}
 
-    } catch (std::exception& e) {
-        LOG_ERROR << "Exception: " << e.what() << std::endl;
-        return false;
-    }
+bool RendererImpl::Load(const std::shared_ptr<IShader>& shader)
+{
+    return LoadResource(shader, m_shader_handles);
+}
 
-    return true;
+bool RendererImpl::Load(const std::shared_ptr<ITexture>& texture)
+{
+    return LoadResource(texture, m_texture_handles);
 }
 
-bool RendererImpl::Load(const std::shared_ptr<IShader>& shader)
+void RendererImpl::LoadAsync(const std::shared_ptr<IMesh>& mesh, LoadCallback callback)
 {
-    if (!m_running) {
-        LOG_ERROR << "Renderer not initialized" << std::endl;
-        return false;
+    std::size_t bytes = mesh->GetVertexData().data.size();
+    for (const auto& submesh : mesh->GetSubMeshes()) {
+        bytes += submesh.indices.size() * sizeof(unsigned int);
     }
 
-    try {
-        auto result = SubmitWithResult<bool>([this, &shader] { return m_renderer_module->Load(shader); });
-        result.get();
+    QueueUpload(ResourceType::Mesh, mesh, bytes, std::move(callback));
+}
 
-    } catch (std::exception& e) {
-        LOG_ERROR << "Exception: " << e.what() << std::endl;
-        return false;
-    }
+void RendererImpl::LoadAsync(const std::shared_ptr<IShader>& shader, LoadCallback callback)
+{
+    // Shaders are small, their compilation only counts against the time budget
+    QueueUpload(ResourceType::Shader, shader, 0, std::move(callback));
+}
 
-    return true;
+void RendererImpl::LoadAsync(const std::shared_ptr<ITexture>& texture, LoadCallback callback)
+{
+    QueueUpload(ResourceType::Texture, texture, 0, std::move(callback));
 }
 
-bool RendererImpl::Load(const std::shared_ptr<ITexture>& texture)
+void RendererImpl::Render(const std::shared_ptr<IMesh>& mesh, const std::shared_ptr<IShader>& shader, std::vector<Property> properties)
 {
-    if (!m_running) {
-        LOG_ERROR << "Renderer not initialized" << std::endl;
-        return false;
-    }
+    Render(mesh, shader, std::move(properties), DrawOrder{});
+}
 
-    try {
-        auto result = SubmitWithResult<bool>([this, &texture] { return m_renderer_module->Load(texture); });
-        result.get();
+void RendererImpl::Render(const std::shared_ptr<IMesh>& mesh, const std::shared_ptr<IMaterial>& material)
+{}
 
-    } catch (std::exception& e) {
-        LOG_ERROR << "Exception: " << e.what() << std::endl;
-        return false;
+void RendererImpl::Render(const std::shared_ptr<IMesh>& mesh,
+                          const std::shared_ptr<IShader>& shader,
+                          std::vector<Property> properties,
+                          const DrawOrder& order)
+{
+    m_bindings.clear();
+    for (auto& property : properties) {
+        m_bindings.push_back({.id = PropertyId(property.name), .value = std::move(property.value)});
     }
 
-    return true;
+    Render(mesh, shader, m_bindings, order);
 }
 
-void RendererImpl::Render(const std::shared_ptr<IMesh>& mesh, const std::shared_ptr<IShader>& shader, std::vector<Property> properties)
+void RendererImpl::Render(const std::shared_ptr<IMesh>& mesh,
+                          const std::shared_ptr<IShader>& shader,
+                          std::span<const PropertyBinding> properties,
+                          const DrawOrder& order)
 {
-    graphics::RenderCommand cmd{
-        .mesh           = mesh->GetId(),
-        .shader         = shader->GetId(),
-        .properties     = std::move(properties),
-        .instance_count = 1,
-    };
+    const auto mesh_it   = m_mesh_handles.find(mesh->GetId());
+    const auto shader_it = m_shader_handles.find(shader->GetId());
+    if (mesh_it == m_mesh_handles.end() || shader_it == m_shader_handles.end()) {
+        ReportNotLoaded(*mesh, m_mesh_handles);
+        ReportNotLoaded(*shader, m_shader_handles);
+        return;
+    }
 
     std::lock_guard<std::mutex> lock(m_commands_mutex);
-    m_commands.push_back(std::move(cmd));
-}
 
-void RendererImpl::Render(const std::shared_ptr<IMesh>& mesh, const std::shared_ptr<IMaterial>& material)
-{}
+    graphics::PropertyRange range = m_properties.Append(properties);
+    ValidateProperties(*shader, range);
+
+    m_commands.push_back({
+        .mesh           = mesh_it->second,
+        .shader         = shader_it->second,
+        .properties     = range,
+        .instance_count = 1,
+        .sort_key       = MakeSortKey(order, shader_it->second, mesh_it->second, m_transparent_sorting),
+    });
+}
 
 void RendererImpl::EndFrame()
 {
     using namespace graphics;
 
+    PROFILE_ZONE("RendererImpl::EndFrame");
+
     try {
-        std::deque<RenderCommand> commands;
+        CompleteUploads();
+
+        std::vector<RenderCommand> commands;
+        PropertyBuffer properties;
         {
             std::lock_guard<std::mutex> lock(m_commands_mutex);
             std::swap(m_commands, commands);
+            std::swap(m_properties, properties);
+
+            // The next frame is likely about as big as this one
+            m_commands.reserve(commands.size());
+            m_properties.Reserve(properties.GetPropertiesCount(), properties.GetDataSize());
         }
 
-        Submit([this, commands = std::move(commands)] {
-            m_renderer_module->Execute(BeginFrameCommand{});
+        const std::uint64_t frame = m_submitted_frames + 1;
+        const auto in_flight      = static_cast<std::size_t>(m_submitted_frames - m_frame_fence.GetCompletedFrame());
+        m_frame_stats->RecordFramesInFlight(in_flight);
 
-            for (const auto& cmd : commands) {
-                m_renderer_module->Execute(cmd);
+        if (in_flight >= m_max_frames_in_flight) {
+            if (m_frame_backpressure == FrameBackpressure::SkipFrame) {
+                m_frame_stats->RecordSkippedFrame();
+                return;
             }
 
-            m_renderer_module->Execute(EndFrameCommand{});
+            PROFILE_ZONE("RendererImpl::Stall");
+            FrameStatsCollector::ScopedTimer timer(*m_frame_stats, FramePhase::Stall);
+            m_frame_fence.Wait(frame - m_max_frames_in_flight);
+        }
+
+        m_submitted_frames = frame;
+        Submit(RenderLane::Frame, [this, frame, commands = std::move(commands), properties = std::move(properties)]() mutable {
+            // The fence is signaled even if the frame fails, EndFrame may be waiting for it
+            try {
+                ExecuteFrame(commands, properties);
+            } catch (...) {
+                m_frame_fence.Signal(frame);
+                throw;
+            }
 
-            m_context->SwapBuffers();
+            m_frame_fence.Signal(frame);
         });
 
     } catch (std::exception& e) {
@@ -167,88 +230,409 @@ void RendererImpl::Shutdown()
 
     try {
         if (m_thread.joinable() && m_renderer_module && m_context) {
+            // Stopping in the same task, so no upload can run after the module is shut down
             auto result = SubmitWithResult<bool>([this] {
                 m_renderer_module->Shutdown();
                 m_context->DropCurrent();
+                m_running = false;
 
                 return true;
             });
             result.get();
-
-            m_running = false;
-            m_cv.notify_all();
             m_thread.join();
         }
     } catch (std::exception& e) {
         LOG_ERROR << "Exception: " << e.what() << std::endl;
     }
 
+    m_mesh_handles.clear();
+    m_shader_handles.clear();
+    m_texture_handles.clear();
+    m_shader_layouts.clear();
+
+    m_finished_uploads.clear();
+    m_completed_uploads.clear();
+
     m_renderer_module.reset();
     m_context.reset();
 }
 
+void RendererImpl::SetFramesInFlight(std::size_t frames, FrameBackpressure backpressure)
+{
+    m_max_frames_in_flight = std::max<std::size_t>(frames, 1);
+    m_frame_backpressure   = backpressure;
+}
+
+void RendererImpl::SetTransparentSorting(TransparentSorting sorting)
+{
+    m_transparent_sorting = sorting;
+}
+
+void RendererImpl::SetAutomaticInstancing(bool enabled)
+{
+    m_automatic_instancing = enabled;
+}
+
+void RendererImpl::SetUploadBudget(std::size_t bytes, std::chrono::microseconds time)
+{
+    m_upload_bytes_per_frame = bytes;
+    m_upload_time_per_frame  = time;
+}
+
+void RendererImpl::SetUploadLane(RenderLane lane)
+{
+    m_upload_lane = lane;
+}
+
+void RendererImpl::WaitForFrames()
+{
+    if (!m_running) {
+        return;
+    }
+
+    // Queued behind the frames in their lane
+    auto result = SubmitWithResult<bool>([] { return true; }, RenderLane::Frame);
+    result.get();
+}
+
 #pragma endregion
 
 #pragma region RendererImpl private methods
 
-void RendererImpl::Submit(Task task)
+void RendererImpl::Submit(RenderLane lane, Task task)
 {
-    std::lock_guard lock(m_mutex);
-    m_tasks.push_back(std::move(task));
-
-    m_cv.notify_one();
+    m_tasks.Push(lane, std::move(task));
 }
 
-template <typename TResult>
+template <typename TResult, typename TCallable>
 [[nodiscard]]
-std::future<TResult> RendererImpl::SubmitWithResult(std::function<TResult()> task)
+std::future<TResult> RendererImpl::SubmitWithResult(TCallable task, RenderLane lane)
 {
-    auto promise = std::make_shared<std::promise<TResult>>();
-    auto future  = promise->get_future();
+    std::promise<TResult> promise;
+    auto future = promise.get_future();
 
-    Submit([p = std::move(promise), t = std::move(task)]() mutable {
+    Submit(lane, [p = std::move(promise), t = std::move(task)]() mutable {
         try {
-            p->set_value(t());
+            p.set_value(t());
         } catch (...) {
-            p->set_exception(std::current_exception());
+            p.set_exception(std::current_exception());
         }
     });
 
     return future;
 }
 
-void RendererImpl::RenderLoop()
+template <typename TResource>
+bool RendererImpl::LoadResource(const std::shared_ptr<TResource>& resource, Handles& handles)
 {
-    // Signal tread start
-    m_init_promise.set_value();
+    if (!m_running) {
+        LOG_ERROR << "Renderer not initialized" << std::endl;
+        return false;
+    }
 
-    while (m_running) {
-        std::deque<Task> tasks;
+    if (handles.contains(resource->GetId())) {
+        return true;
+    }
 
-        {
-            std::unique_lock lock(m_mutex);
-            m_cv.wait(lock, [this] { return !m_running || !m_tasks.empty(); });
+    try {
+        // Written by the render thread while this one waits for the result
+        std::unique_ptr<ShaderLayout> layout;
+
+        auto result = SubmitWithResult<graphics::RenderHandle>([this, &resource, &layout] {
+            const graphics::RenderHandle handle = m_renderer_module->Load(resource);
+            if constexpr (std::is_same_v<TResource, IShader>) {
+                layout = ResolveShaderProperties(handle);
+            }
+            return handle;
+        });
 
-            if (!m_running) {
+        const graphics::RenderHandle handle = result.get();
+        if (!handle.IsValid()) {
+            LOG_ERROR << "Resource '" << resource->GetName() << "' not loaded" << std::endl;
+            return false;
+        }
+
+        handles.emplace(resource->GetId(), handle);
+        if (layout) {
+            m_shader_layouts.insert_or_assign(resource->GetId(), std::move(*layout));
+        }
+
+        MarkLoadedInGPU(*resource);
+
+    } catch (std::exception& e) {
+        LOG_ERROR << "Exception: " << e.what() << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+void RendererImpl::QueueUpload(ResourceType type, std::shared_ptr<IResource> resource, std::size_t bytes, LoadCallback callback)
+{
+    if (!m_running) {
+        LOG_ERROR << "Renderer not initialized" << std::endl;
+        if (callback) {
+            callback(false);
+        }
+        return;
+    }
+
+    if (GetHandles(type).contains(resource->GetId())) {
+        if (callback) {
+            callback(true);
+        }
+        return;
+    }
+
+    m_pending_uploads.insert(resource->GetId());
+
+    Upload upload{
+        .type     = type,
+        .resource = std::move(resource),
+        .callback = std::move(callback),
+        .bytes    = bytes,
+        .handle   = {},
+        .layout   = {},
+    };
+    Submit(m_upload_lane, [this, upload = std::move(upload)]() mutable { ExecuteUpload(upload); });
+}
+
+std::unique_ptr<RendererImpl::ShaderLayout> RendererImpl::ResolveShaderProperties(graphics::RenderHandle shader)
+{
+    auto properties = m_renderer_module->GetShaderProperties(shader);
+    if (!properties) {
+        return nullptr;
+    }
+
+    auto layout = std::make_unique<ShaderLayout>();
+    for (auto& property : *properties) {
+        property.id = PropertyId(property.name);
+
+        const std::size_t index = property.id.GetIndex();
+        if (index >= layout->accepted_types.size()) {
+            layout->accepted_types.resize(index + 1, 0);
+        }
+        layout->accepted_types[index] = property.accepted_types;
+    }
+
+    m_renderer_module->ResolveShaderProperties(shader, *properties);
+
+    return layout;
+}
+
+void RendererImpl::ReportNotLoaded(const IResource& resource, const Handles& handles)
+{
+    const ResourceId id = resource.GetId();
+    if (handles.contains(id) || m_pending_uploads.contains(id)) {
+        return;
+    }
+
+    if (m_reported_resources.insert(id).second) {
+        LOG_ERROR << "Resource '" << resource.GetName() << "' not loaded, its draws are skipped" << std::endl;
+    }
+}
+
+void RendererImpl::ValidateProperties(const IShader& shader, graphics::PropertyRange& range)
+{
+    const auto it = m_shader_layouts.find(shader.GetId());
+    if (it == m_shader_layouts.end()) {
+        return;
+    }
+
+    auto& layout      = it->second;
+    auto packed       = m_properties.Get(range);
+    std::size_t count = packed.size();
+
+    for (std::size_t i = 0; i < count;) {
+        const auto& property    = packed[i];
+        const std::size_t index = property.id.GetIndex();
+
+        const std::uint32_t accepted_types = index < layout.accepted_types.size() ? layout.accepted_types[index] : 0;
+
+        // The transform may feed the instance attribute of the shader instead of a uniform
+        if ((accepted_types & graphics::GetPropertyTypeBit(property.type)) != 0 || property.id == m_transform_id) {
+            ++i;
+            continue;
+        }
+
+        if (index >= layout.reported.size()) {
+            layout.reported.resize(index + 1, false);
+        }
+
+        if (!layout.reported[index]) {
+            layout.reported[index] = true;
+            LOG_ERROR << "Shader '" << shader.GetName() << "' "
+                      << (accepted_types != 0 ? "uniform type doesn't match the property '" : "has no uniform for the property '")
+                      << property.id.GetName() << "'" << std::endl;
+        }
+
+        // Property order doesn't matter, move it to the end of the range and drop it
+        std::swap(packed[i], packed[count - 1]);
+        --count;
+    }
+
+    range.count = static_cast<std::uint32_t>(count);
+}
+
+void RendererImpl::ExecuteUpload(Upload& upload)
+{
+    using Clock = std::chrono::steady_clock;
+
+    PROFILE_ZONE("RendererImpl::ExecuteUpload");
+
+    const auto start = Clock::now();
+    try {
+        switch (upload.type) {
+            case ResourceType::Mesh:    upload.handle = m_renderer_module->Load(std::static_pointer_cast<IMesh>(upload.resource)); break;
+            case ResourceType::Shader:
+                upload.handle = m_renderer_module->Load(std::static_pointer_cast<IShader>(upload.resource));
+                upload.layout = ResolveShaderProperties(upload.handle);
                 break;
+            case ResourceType::Texture: upload.handle = m_renderer_module->Load(std::static_pointer_cast<ITexture>(upload.resource)); break;
+
+            default: break;
+        }
+    } catch (std::exception& e) {
+        LOG_ERROR << "Exception: " << e.what() << std::endl;
+    }
+
+    const auto duration = Clock::now() - start;
+    m_frame_stats->Record(FramePhase::Upload, duration);
+
+    ++m_uploads_done;
+    m_upload_bytes_used += upload.bytes;
+    m_upload_time_used += std::chrono::duration_cast<std::chrono::nanoseconds>(duration);
+
+    std::lock_guard<std::mutex> lock(m_uploads_mutex);
+    m_finished_uploads.push_back(std::move(upload));
+}
+
+void RendererImpl::CompleteUploads()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_uploads_mutex);
+        std::swap(m_finished_uploads, m_completed_uploads);
+    }
+
+    for (auto& upload : m_completed_uploads) {
+        if (const auto it = m_pending_uploads.find(upload.resource->GetId()); it != m_pending_uploads.end()) {
+            m_pending_uploads.erase(it);
+        }
+
+        const bool loaded = upload.handle.IsValid();
+        if (loaded) {
+            const auto [_, inserted] = GetHandles(upload.type).emplace(upload.resource->GetId(), upload.handle);
+            if (inserted && upload.layout) {
+                m_shader_layouts.insert_or_assign(upload.resource->GetId(), std::move(*upload.layout));
             }
 
-            swap(tasks, m_tasks);
+            if (!inserted) {
+                // Loaded another way meanwhile, the copy isn't needed
+                Submit(RenderLane::Critical, [this, type = upload.type, handle = upload.handle] {
+                    m_renderer_module->Unload(type, handle);
+                });
+            }
+
+            MarkLoadedInGPU(*upload.resource);
+        } else {
+            LOG_ERROR << "Resource '" << upload.resource->GetName() << "' not loaded" << std::endl;
+        }
+
+        if (upload.callback) {
+            upload.callback(loaded);
         }
+    }
+
+    m_completed_uploads.clear();
+}
+
+RendererImpl::Handles& RendererImpl::GetHandles(ResourceType type)
+{
+    switch (type) {
+        case ResourceType::Mesh:    return m_mesh_handles;
+        case ResourceType::Shader:  return m_shader_handles;
+        case ResourceType::Texture:
+        default:                    return m_texture_handles;
+    }
+}
+
+void RendererImpl::RenderLoop()
+{
+    PROFILE_THREAD("Render");
+
+    // Signal tread start
+    m_init_promise.set_value();
+
+    Task task;
+    RenderTaskQueue::TaskInfo info;
+    while (m_running) {
+        // Background work only gets the frame time left by the budget, the lanes before it always run first
+        const bool upload_budget_left = m_uploads_done == 0 ||
+                                        (m_upload_bytes_used < m_upload_bytes_per_frame && m_upload_time_used < m_upload_time_per_frame);
+        const RenderLane last_lane    = upload_budget_left ? RenderLane::Background : RenderLane::Critical;
+
+        if (!m_tasks.TryPop(last_lane, task, info)) {
+            m_tasks.Wait(last_lane);
+            continue;
+        }
+
+        m_frame_stats->RecordQueueLatency(info.lane, RenderTaskQueue::Clock::now() - info.queued_at);
 
         try {
-            for (auto& task : tasks) {
-                task();
-            }
+            PROFILE_ZONE("RendererImpl::RunTask");
+            task();
 
         } catch (std::exception& e) {
             LOG_ERROR << "Exception: " << e.what() << std::endl;
         } catch (...) {
             LOG_ERROR << "Unknown Exception" << std::endl;
         }
+
+        task.Reset();
     }
 }
 
+void RendererImpl::ExecuteFrame(std::vector<graphics::RenderCommand>& commands, graphics::PropertyBuffer& properties)
+{
+    using namespace graphics;
+
+    {
+        PROFILE_ZONE("RendererImpl::ExecuteFrame");
+        FrameStatsCollector::ScopedTimer timer(*m_frame_stats, FramePhase::RenderExecution);
+
+        std::span<const std::uint32_t> draws = m_sorter.Sort(commands);
+        if (m_automatic_instancing) {
+            draws = m_batcher.Batch(commands, properties, draws);
+        }
+
+        m_renderer_module->Execute(BeginFrameCommand{
+            .properties          = &properties,
+            .instance_transforms = m_automatic_instancing ? m_batcher.GetInstanceTransforms() : std::span<const Matrix4>{},
+        });
+
+        for (const std::uint32_t index : draws) {
+            m_renderer_module->Execute(commands[index]);
+        }
+
+        m_renderer_module->Execute(EndFrameCommand{});
+        m_frame_stats->RecordDrawCalls(m_renderer_module->GetDrawCallsCount());
+
+        const auto state_changes = m_renderer_module->GetStateChanges();
+        m_frame_stats->RecordStateChanges(state_changes.issued, state_changes.skipped);
+    }
+
+    {
+        PROFILE_ZONE("RendererImpl::SwapBuffers");
+        FrameStatsCollector::ScopedTimer timer(*m_frame_stats, FramePhase::SwapBuffers);
+        m_context->SwapBuffers();
+    }
+
+    // The next frame's budget for background uploads
+    m_uploads_done      = 0;
+    m_upload_bytes_used = 0;
+    m_upload_time_used  = {};
+}
+
 #pragma endregion
 
 } // namespace game_engine
@@ -1,20 +1,29 @@
 #pragma once
 
-#include <condition_variable>
-#include <deque>
-#include <functional>
+#include <chrono>
 #include <future>
 #include <memory>
 #include <mutex>
+#include <span>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
+#include <engine/game_settings.hpp>
 #include <engine/graphics/renderer.hpp>
 
+#include <graphics/frame_fence.hpp>
+#include <graphics/instance_batcher.hpp>
+#include <graphics/render_sort.hpp>
+#include <graphics/render_task_queue.hpp>
+#include <modules/graphics/property_buffer.hpp>
 #include <modules/graphics/render_command.hpp>
 
 // Forward declarations
 namespace game_engine
 {
+class FrameStatsCollector;
 class ModuleLocator;
 class RenderContextImpl;
 
@@ -31,7 +40,9 @@ class RendererImpl final : public IRenderer
 {
 public:
 
-    explicit RendererImpl(const ModuleLocator& locator);
+    /// @param locator        Provides the backend and renderer modules.
+    /// @param frame_stats    Receives the render thread timings.
+    RendererImpl(const ModuleLocator& locator, std::shared_ptr<FrameStatsCollector> frame_stats);
     ~RendererImpl() override;
 
     RendererImpl(const RendererImpl&) = delete;
@@ -45,8 +56,20 @@ public:
     bool Load(const std::shared_ptr<IShader>& shader) override;
     bool Load(const std::shared_ptr<ITexture>& texture) override;
 
+    void LoadAsync(const std::shared_ptr<IMesh>& mesh, LoadCallback callback) override;
+    void LoadAsync(const std::shared_ptr<IShader>& shader, LoadCallback callback) override;
+    void LoadAsync(const std::shared_ptr<ITexture>& texture, LoadCallback callback) override;
+
     void Render(const std::shared_ptr<IMesh>& mesh, const std::shared_ptr<IShader>& shader, std::vector<Property> properties) override;
     void Render(const std::shared_ptr<IMesh>& mesh, const std::shared_ptr<IMaterial>& material) override;
+    void Render(const std::shared_ptr<IMesh>& mesh,
+                const std::shared_ptr<IShader>& shader,
+                std::vector<Property> properties,
+                const DrawOrder& order) override;
+    void Render(const std::shared_ptr<IMesh>& mesh,
+                const std::shared_ptr<IShader>& shader,
+                std::span<const PropertyBinding> properties,
+                const DrawOrder& order) override;
 
     void EndFrame() override;
 
@@ -54,33 +77,139 @@ public:
     bool Init();
     void Shutdown();
 
-private:
+    /// @brief Limits the frames EndFrame hands to the render thread before they are presented.
+    /// @param frames          Frames in flight at most, at least 1.
+    /// @param backpressure    What EndFrame does when the limit is reached.
+    void SetFramesInFlight(std::size_t frames, FrameBackpressure backpressure);
+
+    /// @brief Sets the order of the transparent draw calls recorded from now on.
+    void SetTransparentSorting(TransparentSorting sorting);
+
+    /// @brief Enables merging identical draws into instanced ones, see InstanceBatcher. Call before Init.
+    void SetAutomaticInstancing(bool enabled);
+
+    /// @brief Limits the RenderLane::Background uploads of a frame, the render thread stops after the resource
+    /// exceeding a limit. The first upload of a frame always runs, so zero limits upload one resource per frame.
+    void SetUploadBudget(std::size_t bytes, std::chrono::microseconds time);
+
+    /// @brief Sets the lane of the LoadAsync uploads queued from now on.
+    void SetUploadLane(RenderLane lane);
 
-    using Task = std::function<void()>;
+    /// @brief Blocks until the render thread has executed the frames ended so far. Tasks of the other lanes may
+    /// still be queued.
+    void WaitForFrames();
 
-    void Submit(Task task);
+private:
 
-    template <typename TResult>
+    using Task    = RenderTaskQueue::Task;
+    using Handles = std::unordered_map<ResourceId, graphics::RenderHandle>;
+
+    /// @brief Properties a loaded shader accepts, see IRendererModule::GetShaderProperties.
+    struct ShaderLayout
+    {
+        std::vector<std::uint32_t> accepted_types; ///< Property type bits, indexed by PropertyId::GetIndex.
+        std::vector<bool> reported;                ///< Properties already reported as invalid, by the same index.
+    };
+
+    /// @brief Resource queued by LoadAsync.
+    struct Upload
+    {
+        ResourceType type = ResourceType::Unknown;
+        std::shared_ptr<IResource> resource;
+        LoadCallback callback;
+        std::size_t bytes = 0;         ///< Estimated size of the data to upload.
+        graphics::RenderHandle handle; ///< Set by the render thread, invalid if the upload failed.
+        std::unique_ptr<ShaderLayout> layout; ///< Set by the render thread for shaders.
+    };
+
+    static constexpr std::size_t TaskQueueCapacity = 256;
+
+    /// @brief Hands a task to the render thread. Must be called from one thread at a time, the game thread.
+    void Submit(RenderLane lane, Task task);
+
+    template <typename TResult, typename TCallable>
     [[nodiscard]]
-    std::future<TResult> SubmitWithResult(std::function<TResult()> task);
+    std::future<TResult> SubmitWithResult(TCallable task, RenderLane lane = RenderLane::Critical);
+
+    /// @brief Loads the resource on the render thread once and keeps the module's handle for it.
+    template <typename TResource>
+    bool LoadResource(const std::shared_ptr<TResource>& resource, Handles& handles);
+
+    void QueueUpload(ResourceType type, std::shared_ptr<IResource> resource, std::size_t bytes, LoadCallback callback);
+
+    /// @brief Resolves the properties of a loaded shader in the module once, before its first draw. Render thread only.
+    /// @return Null if the module doesn't reflect shaders.
+    std::unique_ptr<ShaderLayout> ResolveShaderProperties(graphics::RenderHandle shader);
+
+    /// @brief Reports a resource a draw needs if it isn't loaded and no upload of it is queued, once per resource.
+    void ReportNotLoaded(const IResource& resource, const Handles& handles);
+
+    /// @brief Drops the properties the shader doesn't accept from the range, reporting each once.
+    void ValidateProperties(const IShader& shader, graphics::PropertyRange& range);
+
+    /// @brief Uploads the resource and counts it against the frame's upload budget. Render thread only.
+    void ExecuteUpload(Upload& upload);
+
+    /// @brief Keeps the handles of the finished uploads and calls their callbacks. Main thread only.
+    void CompleteUploads();
+
+    Handles& GetHandles(ResourceType type);
 
     void RenderLoop();
 
+    /// @brief Executes the commands of one frame in sort key order and presents it. Render thread only.
+    /// Merged draws are modified in place.
+    void ExecuteFrame(std::vector<graphics::RenderCommand>& commands, graphics::PropertyBuffer& properties);
+
     std::shared_ptr<RenderContextImpl> m_context;
 
     std::shared_ptr<graphics::IRendererModule> m_renderer_module;
+    std::shared_ptr<FrameStatsCollector> m_frame_stats;
 
     std::atomic<bool> m_running = false;
     std::thread m_thread;
 
-    std::deque<Task> m_tasks;
-    std::mutex m_mutex;
-    std::condition_variable m_cv;
+    RenderTaskQueue m_tasks{TaskQueueCapacity};
 
     std::promise<void> m_init_promise;
 
+    // Module handles of the loaded resources, used by the game thread only
+    Handles m_mesh_handles;
+    Handles m_shader_handles;
+    Handles m_texture_handles;
+    std::unordered_map<ResourceId, ShaderLayout> m_shader_layouts;
+    std::unordered_multiset<ResourceId> m_pending_uploads; ///< Resources queued by LoadAsync and not completed yet.
+    std::unordered_set<ResourceId> m_reported_resources;   ///< Resources already reported as not loaded.
+
+    std::mutex m_uploads_mutex;
+    std::vector<Upload> m_finished_uploads;  ///< Done by the render thread, completed by the main thread.
+    std::vector<Upload> m_completed_uploads; ///< Main thread buffer of CompleteUploads.
+
+    RenderLane m_upload_lane                          = RenderLane::Background;
+    std::size_t m_upload_bytes_per_frame              = 4 * 1024 * 1024;
+    std::chrono::microseconds m_upload_time_per_frame = std::chrono::microseconds(2000);
+
+    // Upload budget used since the last frame, render thread only
+    std::size_t m_uploads_done      = 0;
+    std::size_t m_upload_bytes_used = 0;
+    std::chrono::nanoseconds m_upload_time_used{};
+
     std::mutex m_commands_mutex;
-    std::deque<graphics::RenderCommand> m_commands;
+    std::vector<graphics::RenderCommand> m_commands;
+    graphics::PropertyBuffer m_properties;
+    std::vector<PropertyBinding> m_bindings; ///< Conversion buffer of the Property overloads.
+    const PropertyId m_transform_id{graphics::InstanceTransformProperty};
+
+    std::size_t m_max_frames_in_flight     = 2;
+    FrameBackpressure m_frame_backpressure = FrameBackpressure::Block;
+    std::uint64_t m_submitted_frames       = 0; ///< Number of the last frame handed to the render thread.
+    FrameFence m_frame_fence;
+
+    TransparentSorting m_transparent_sorting = TransparentSorting::SubmissionOrder;
+    RenderCommandSorter m_sorter; ///< Used by the render thread only.
+
+    bool m_automatic_instancing = false;
+    InstanceBatcher m_batcher; ///< Used by the render thread only.
 };
 
 } // namespace game_engine
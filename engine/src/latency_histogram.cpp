@@ -0,0 +1,128 @@
+#include "latency_histogram.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace game_engine
+{
+
+void LatencyHistogram::Record(std::chrono::nanoseconds duration) noexcept
+{
+    const auto value = static_cast<std::uint64_t>(std::max(duration.count(), std::chrono::nanoseconds::rep{0}));
+
+    Window& window = m_windows[m_current.load(std::memory_order_acquire)];
+    window.buckets[BucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+    window.sum.fetch_add(value, std::memory_order_relaxed);
+
+    std::uint64_t min = window.min.load(std::memory_order_relaxed);
+    while (value < min && !window.min.compare_exchange_weak(min, value, std::memory_order_relaxed)) {}
+
+    std::uint64_t max = window.max.load(std::memory_order_relaxed);
+    while (value > max && !window.max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {}
+
+    // Published last, readers that see the count see the bucket too
+    window.count.fetch_add(1, std::memory_order_release);
+}
+
+void LatencyHistogram::Rotate() noexcept
+{
+    const std::size_t next = 1 - m_current.load(std::memory_order_relaxed);
+
+    // A writer that picked the window before the switch may still add a sample to it, it is then counted later
+    m_windows[next].Clear();
+    m_current.store(next, std::memory_order_release);
+}
+
+void LatencyHistogram::Reset() noexcept
+{
+    for (Window& window : m_windows) {
+        window.Clear();
+    }
+}
+
+PhaseTimings LatencyHistogram::GetTimings() const noexcept
+{
+    std::uint64_t count = 0;
+    std::uint64_t sum   = 0;
+    std::uint64_t min   = std::numeric_limits<std::uint64_t>::max();
+    std::uint64_t max   = 0;
+
+    for (const Window& window : m_windows) {
+        count += window.count.load(std::memory_order_acquire);
+        sum += window.sum.load(std::memory_order_relaxed);
+        min = std::min(min, window.min.load(std::memory_order_relaxed));
+        max = std::max(max, window.max.load(std::memory_order_relaxed));
+    }
+
+    if (count == 0) {
+        return {};
+    }
+
+    // Each percentile is the smallest bucket that holds at least that share of the samples
+    const std::array<std::uint64_t, 3> targets = {count - count / 2, count - count / 10, count - count / 100};
+    std::array<std::uint64_t, 3> percentiles   = {max, max, max};
+
+    std::uint64_t seen = 0;
+    std::size_t next   = 0;
+    for (std::size_t bucket = 0; bucket < BucketsCount && next < targets.size(); ++bucket) {
+        for (const Window& window : m_windows) {
+            seen += window.buckets[bucket].load(std::memory_order_relaxed);
+        }
+
+        for (; next < targets.size() && seen >= targets[next]; ++next) {
+            percentiles[next] = std::clamp(UpperBoundOf(bucket), min, max);
+        }
+    }
+
+    using Duration = std::chrono::nanoseconds;
+    using Rep      = Duration::rep;
+
+    return {
+        .min     = Duration(static_cast<Rep>(min)),
+        .average = Duration(static_cast<Rep>(sum / count)),
+        .max     = Duration(static_cast<Rep>(max)),
+        .p50     = Duration(static_cast<Rep>(percentiles[0])),
+        .p90     = Duration(static_cast<Rep>(percentiles[1])),
+        .p99     = Duration(static_cast<Rep>(percentiles[2])),
+        .samples = count,
+    };
+}
+
+std::size_t LatencyHistogram::BucketOf(std::uint64_t value) noexcept
+{
+    if (value < SubBuckets) {
+        return static_cast<std::size_t>(value);
+    }
+
+    // Top bit selects the power of two, the next SubBucketBits bits select the sub-bucket
+    const auto top = static_cast<std::size_t>(std::bit_width(value) - 1);
+    const auto sub = static_cast<std::size_t>(value >> (top - SubBucketBits)) & (SubBuckets - 1);
+
+    return (top - SubBucketBits + 1) * SubBuckets + sub;
+}
+
+std::uint64_t LatencyHistogram::UpperBoundOf(std::size_t bucket) noexcept
+{
+    if (bucket < SubBuckets) {
+        return bucket;
+    }
+
+    const std::size_t shift   = bucket / SubBuckets - 1;
+    const std::uint64_t lower = static_cast<std::uint64_t>(SubBuckets + bucket % SubBuckets) << shift;
+
+    return lower + ((std::uint64_t{1} << shift) - 1);
+}
+
+void LatencyHistogram::Window::Clear() noexcept
+{
+    for (auto& bucket : buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+
+    count.store(0, std::memory_order_relaxed);
+    sum.store(0, std::memory_order_relaxed);
+    min.store(std::numeric_limits<std::uint64_t>::max(), std::memory_order_relaxed);
+    max.store(0, std::memory_order_relaxed);
+}
+
+} // namespace game_engine
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include <engine/frame_stats.hpp>
+
+namespace game_engine
+{
+
+/// @brief Lock-free histogram of durations over a rolling window.
+/// Values go to log-linear buckets, 8 per power of two, so percentiles are accurate to 1/8 of the value.
+/// Record may be called from any thread. Samples are kept in two windows, Rotate clears the older one
+/// and makes it current, so GetTimings covers the time between the last two rotations and since then.
+class LatencyHistogram final
+{
+public:
+
+    LatencyHistogram() = default;
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram(LatencyHistogram&&)      = delete;
+
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(LatencyHistogram&&)      = delete;
+
+    /// @brief Adds a sample, negative durations count as zero.
+    void Record(std::chrono::nanoseconds duration) noexcept;
+
+    /// @brief Drops the samples older than the previous rotation. Call from one thread at a time.
+    void Rotate() noexcept;
+
+    /// @brief Drops all samples. Samples recorded concurrently may survive.
+    void Reset() noexcept;
+
+    /// @brief Summarizes both windows. May be called concurrently with Record, the result is then approximate.
+    PhaseTimings GetTimings() const noexcept;
+
+private:
+
+    static constexpr std::size_t SubBucketBits = 3;
+    static constexpr std::size_t SubBuckets    = 1 << SubBucketBits;
+    static constexpr std::size_t BucketsCount  = (64 - SubBucketBits + 1) * SubBuckets;
+
+    static std::size_t BucketOf(std::uint64_t value) noexcept;
+    static std::uint64_t UpperBoundOf(std::size_t bucket) noexcept;
+
+    struct Window
+    {
+        std::array<std::atomic<std::uint64_t>, BucketsCount> buckets{};
+        std::atomic<std::uint64_t> count = 0;
+        std::atomic<std::uint64_t> sum   = 0;
+        std::atomic<std::uint64_t> min   = std::numeric_limits<std::uint64_t>::max();
+        std::atomic<std::uint64_t> max   = 0;
+
+        void Clear() noexcept;
+    };
+
+    std::array<Window, 2> m_windows;
+    std::atomic<std::size_t> m_current = 0;
+};
+
+} // namespace game_engine
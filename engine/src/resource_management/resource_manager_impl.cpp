@@ -1,5 +1,7 @@
 #include "resource_manager_impl.hpp"
 
+#include <engine/utils/profiler.hpp>
+
 #include <resource_management/loaders/material_loader.hpp>
 #include <resource_management/loaders/mesh_loader.hpp>
 #include <resource_management/loaders/shader_loader.hpp>
@@ -65,24 +67,32 @@ ResourceManagerImpl::~ResourceManagerImpl()
 
 std::shared_ptr<IMesh> ResourceManagerImpl::LoadMesh(const std::string_view name, const MeshLoadParams& params)
 {
+    PROFILE_ZONE("ResourceManagerImpl::LoadMesh");
+
     const auto id = GetResourceId(name);
     return LoadResource<MeshResource>(id, name, m_mesh_loader, params, m_meshes);
 }
 
 std::shared_ptr<IShader> ResourceManagerImpl::LoadShader(const std::string_view name, const ShaderLoadParams& params)
 {
+    PROFILE_ZONE("ResourceManagerImpl::LoadShader");
+
     const auto id = GetResourceId(name);
     return LoadResource<ShaderResource>(id, name, m_shader_loader, params, m_shaders);
 }
 
 std::shared_ptr<ITexture> ResourceManagerImpl::LoadTexture(const std::string_view name, const TextureLoadParams& params)
 {
+    PROFILE_ZONE("ResourceManagerImpl::LoadTexture");
+
     const auto id = GetResourceId(name);
     return LoadResource<TextureResource>(id, name, m_texture_loader, params, m_textures);
 }
 
 std::shared_ptr<IMaterial> ResourceManagerImpl::LoadMaterial(const std::string_view name, const MaterialLoadParams& params)
 {
+    PROFILE_ZONE("ResourceManagerImpl::LoadMaterial");
+
     const auto id = GetResourceId(name);
     return LoadResource<MaterialResource>(id, name, m_material_loader, params, m_materials);
 }
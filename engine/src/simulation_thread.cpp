@@ -0,0 +1,99 @@
+#include "simulation_thread.hpp"
+
+#include <utility>
+
+#include <engine/utils/profiler.hpp>
+
+namespace game_engine
+{
+
+SimulationThread::SimulationThread() = default;
+
+SimulationThread::~SimulationThread()
+{
+    Stop();
+}
+
+void SimulationThread::Start(Step step)
+{
+    if (IsRunning()) {
+        return;
+    }
+
+    m_step   = std::move(step);
+    m_stop   = false;
+    m_thread = std::thread(&SimulationThread::ThreadLoop, this);
+}
+
+void SimulationThread::Stop()
+{
+    if (!IsRunning()) {
+        return;
+    }
+
+    if (m_busy) {
+        m_done.acquire();
+        m_busy = false;
+    }
+
+    m_stop = true;
+    m_kick.release();
+    m_thread.join();
+
+    m_exception = nullptr;
+}
+
+bool SimulationThread::IsRunning() const noexcept
+{
+    return m_thread.joinable();
+}
+
+void SimulationThread::Kick(std::size_t steps)
+{
+    m_steps = steps;
+    m_busy  = true;
+    m_kick.release();
+}
+
+void SimulationThread::Wait()
+{
+    if (!m_busy) {
+        return;
+    }
+
+    m_done.acquire();
+    m_busy = false;
+
+    if (m_exception) {
+        std::rethrow_exception(std::exchange(m_exception, nullptr));
+    }
+}
+
+std::thread::id SimulationThread::GetId() const noexcept
+{
+    return m_thread.get_id();
+}
+
+void SimulationThread::ThreadLoop()
+{
+    PROFILE_THREAD("Simulation");
+
+    for (;;) {
+        m_kick.acquire();
+        if (m_stop) {
+            return;
+        }
+
+        try {
+            for (std::size_t i = 0; i < m_steps; ++i) {
+                m_step();
+            }
+        } catch (...) {
+            m_exception = std::current_exception();
+        }
+
+        m_done.release();
+    }
+}
+
+} // namespace game_engine
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <semaphore>
+#include <thread>
+
+namespace game_engine
+{
+
+/// @brief Dedicated thread that runs simulation steps handed over by the main loop.
+/// The main thread calls Kick to start a batch of steps, does its own work, then calls Wait.
+/// Between Wait and the next Kick the simulation thread is idle, so both threads may touch shared state.
+class SimulationThread final
+{
+public:
+
+    /// @brief Runs one simulation step.
+    using Step = std::function<void()>;
+
+    SimulationThread();
+    ~SimulationThread();
+
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread(SimulationThread&&)      = delete;
+
+    SimulationThread& operator=(const SimulationThread&) = delete;
+    SimulationThread& operator=(SimulationThread&&)      = delete;
+
+    /// @brief Starts the thread. Does nothing if it is already running.
+    void Start(Step step);
+
+    /// @brief Finishes the current batch and joins the thread.
+    void Stop();
+
+    bool IsRunning() const noexcept;
+
+    /// @brief Starts running `steps` steps on the simulation thread. Must be followed by Wait.
+    void Kick(std::size_t steps);
+
+    /// @brief Blocks until the batch started by Kick is done. Rethrows an exception thrown by a step.
+    void Wait();
+
+    /// @brief Returns the id of the simulation thread.
+    std::thread::id GetId() const noexcept;
+
+private:
+
+    void ThreadLoop();
+
+    Step m_step;
+    std::thread m_thread;
+
+    std::binary_semaphore m_kick{0};
+    std::binary_semaphore m_done{0};
+
+    std::size_t m_steps = 0; ///< Published to the thread by m_kick.
+    bool m_stop         = false;
+    bool m_busy         = false;
+
+    std::exception_ptr m_exception; ///< Published to the main thread by m_done.
+};
+
+} // namespace game_engine
@@ -0,0 +1,237 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <engine/utils/profiler.hpp>
+
+namespace
+{
+
+using game_engine::profiler::Clock;
+
+struct Zone
+{
+    const char* name;
+    Clock::time_point start;
+    Clock::time_point end;
+};
+
+/// @brief Append-only zone storage of one thread. Only the owning thread writes,
+/// readers see the zones published by the count.
+class ThreadBuffer final
+{
+public:
+
+    static constexpr std::size_t ChunkSize = 4096;
+    static constexpr std::size_t MaxChunks = 256; ///< About 1M zones, 24 MB per thread.
+
+    explicit ThreadBuffer(std::uint32_t thread_id)
+        : m_thread_id(thread_id)
+    {}
+
+    void Push(const Zone& zone) noexcept
+    {
+        const std::size_t index = m_count.load(std::memory_order_relaxed);
+        const std::size_t chunk = index / ChunkSize;
+        if (chunk >= MaxChunks) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        if (!m_chunks[chunk]) {
+            m_chunks[chunk] = std::make_unique<Chunk>();
+        }
+
+        (*m_chunks[chunk])[index % ChunkSize] = zone;
+        m_count.store(index + 1, std::memory_order_release);
+    }
+
+    template <typename TVisitor>
+    void ForEach(TVisitor&& visitor) const
+    {
+        const std::size_t count = m_count.load(std::memory_order_acquire);
+        for (std::size_t i = 0; i < count; ++i) {
+            visitor((*m_chunks[i / ChunkSize])[i % ChunkSize]);
+        }
+    }
+
+    std::uint32_t GetThreadId() const noexcept
+    {
+        return m_thread_id;
+    }
+
+    std::size_t GetDroppedCount() const noexcept
+    {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+
+    std::string name; ///< Guarded by the registry mutex.
+
+private:
+
+    using Chunk = std::array<Zone, ChunkSize>;
+
+    const std::uint32_t m_thread_id;
+
+    std::array<std::unique_ptr<Chunk>, MaxChunks> m_chunks;
+    std::atomic<std::size_t> m_count   = 0;
+    std::atomic<std::size_t> m_dropped = 0;
+};
+
+/// @brief Buffers of all threads that recorded zones, kept after the threads exit.
+struct Registry
+{
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    const Clock::time_point epoch = Clock::now();
+};
+
+Registry& GetRegistry()
+{
+    static Registry s_registry;
+    return s_registry;
+}
+
+ThreadBuffer& GetThreadBuffer()
+{
+    thread_local const std::shared_ptr<ThreadBuffer> s_buffer = [] {
+        Registry& registry = GetRegistry();
+
+        std::lock_guard lock(registry.mutex);
+        const auto thread_id = static_cast<std::uint32_t>(registry.buffers.size() + 1);
+        return registry.buffers.emplace_back(std::make_shared<ThreadBuffer>(thread_id));
+    }();
+
+    return *s_buffer;
+}
+
+void WriteJsonString(std::ostream& stream, std::string_view text)
+{
+    stream << '"';
+    for (const char c : text) {
+        if (c == '"' || c == '\\') {
+            stream << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            stream << ' ';
+        } else {
+            stream << c;
+        }
+    }
+    stream << '"';
+}
+
+/// @brief Writes nanoseconds as microseconds with three decimals, the unit of the trace format.
+void WriteMicroseconds(std::ostream& stream, std::chrono::nanoseconds duration)
+{
+    const auto ns       = std::max<std::int64_t>(duration.count(), 0);
+    const auto fraction = std::to_string(ns % 1000);
+
+    stream << ns / 1000 << '.' << std::string(3 - fraction.size(), '0') << fraction;
+}
+
+} // namespace
+
+namespace game_engine::profiler
+{
+
+#pragma region ScopedZone
+
+ScopedZone::ScopedZone(const char* name) noexcept
+    : m_name(name)
+    , m_start(Clock::now())
+{}
+
+ScopedZone::~ScopedZone()
+{
+    GetThreadBuffer().Push({m_name, m_start, Clock::now()});
+}
+
+#pragma endregion
+
+void SetThreadName(std::string_view name)
+{
+    ThreadBuffer& buffer = GetThreadBuffer();
+
+    std::lock_guard lock(GetRegistry().mutex);
+    buffer.name = name;
+}
+
+void WriteChromeTrace(std::ostream& stream)
+{
+    Registry& registry = GetRegistry();
+
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    std::vector<std::string> names;
+    {
+        std::lock_guard lock(registry.mutex);
+        buffers = registry.buffers;
+        for (const auto& buffer : buffers) {
+            names.push_back(buffer->name);
+        }
+    }
+
+    stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+    bool first = true;
+    auto separator = [&stream, &first] {
+        stream << (first ? "\n" : ",\n");
+        first = false;
+    };
+
+    for (std::size_t i = 0; i < buffers.size(); ++i) {
+        const std::uint32_t tid = buffers[i]->GetThreadId();
+
+        if (!names[i].empty()) {
+            separator();
+            stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid << ",\"args\":{\"name\":";
+            WriteJsonString(stream, names[i]);
+            stream << "}}";
+        }
+
+        buffers[i]->ForEach([&](const Zone& zone) {
+            separator();
+            stream << "{\"name\":";
+            WriteJsonString(stream, zone.name);
+            stream << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid << ",\"ts\":";
+            WriteMicroseconds(stream, zone.start - registry.epoch);
+            stream << ",\"dur\":";
+            WriteMicroseconds(stream, zone.end - zone.start);
+            stream << '}';
+        });
+    }
+
+    stream << "\n]}\n";
+}
+
+bool WriteChromeTrace(const std::filesystem::path& file)
+{
+    std::ofstream stream(file, std::ios::trunc);
+    if (!stream) {
+        return false;
+    }
+
+    WriteChromeTrace(stream);
+    return static_cast<bool>(stream);
+}
+
+std::size_t GetDroppedZonesCount()
+{
+    Registry& registry = GetRegistry();
+
+    std::lock_guard lock(registry.mutex);
+
+    std::size_t dropped = 0;
+    for (const auto& buffer : registry.buffers) {
+        dropped += buffer->GetDroppedCount();
+    }
+
+    return dropped;
+}
+
+} // namespace game_engine::profiler
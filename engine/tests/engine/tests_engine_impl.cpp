@@ -1,3 +1,9 @@
+#include <algorithm>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
 #include <engine/game.hpp>
 
 #include <modules/backend/backend_module.hpp>
@@ -5,6 +11,8 @@
 #include <modules/module_locator.hpp>
 
 #include <engine_impl.hpp>
+#include <resource_management/resources/mesh_resource.hpp>
+#include <resource_management/resources/shader_resource.hpp>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -15,16 +23,28 @@ public:
     MOCK_METHOD(bool, Init, (), (override));
     MOCK_METHOD(void, Shutdown, (), (noexcept, override));
 
-    MOCK_METHOD(bool, Load, (const std::shared_ptr<game_engine::IMesh>&), (override));
-    MOCK_METHOD(bool, Load, (const std::shared_ptr<game_engine::IShader>&), (override));
-    MOCK_METHOD(bool, Load, (const std::shared_ptr<game_engine::ITexture>&), (override));
+    MOCK_METHOD(game_engine::graphics::RenderHandle, Load, (const std::shared_ptr<game_engine::IMesh>&), (override));
+    MOCK_METHOD(game_engine::graphics::RenderHandle, Load, (const std::shared_ptr<game_engine::IShader>&), (override));
+    MOCK_METHOD(game_engine::graphics::RenderHandle, Load, (const std::shared_ptr<game_engine::ITexture>&), (override));
 
-    MOCK_METHOD(void, Unload, (game_engine::ResourceType type, game_engine::ResourceId id), (override));
+    MOCK_METHOD(void, Unload, (game_engine::ResourceType type, game_engine::graphics::RenderHandle handle), (override));
     MOCK_METHOD(void, UnloadAll, (), (override));
 
     MOCK_METHOD(void, Execute, (const game_engine::graphics::BeginFrameCommand& command), (override));
     MOCK_METHOD(void, Execute, (const game_engine::graphics::EndFrameCommand& command), (override));
     MOCK_METHOD(void, Execute, (const game_engine::graphics::RenderCommand& command), (override));
+
+    MOCK_METHOD(std::optional<std::vector<game_engine::graphics::ShaderProperty>>,
+                GetShaderProperties,
+                (game_engine::graphics::RenderHandle shader),
+                (const, override));
+    MOCK_METHOD(void,
+                ResolveShaderProperties,
+                (game_engine::graphics::RenderHandle shader, std::span<const game_engine::graphics::ShaderProperty> properties),
+                (override));
+
+    MOCK_METHOD(std::uint32_t, GetDrawCallsCount, (), (const, noexcept, override));
+    MOCK_METHOD(game_engine::graphics::StateChangeStats, GetStateChanges, (), (const, noexcept, override));
 };
 
 class MockBackend : public game_engine::backend::IBackendModule
@@ -53,6 +73,7 @@ public:
 
     MOCK_METHOD(void, OnUpdate, (std::chrono::nanoseconds elapsedTime), (override));
     MOCK_METHOD(void, OnDraw, (), (override));
+    MOCK_METHOD(void, OnSync, (), (override));
     MOCK_METHOD(bool, OnShouldClose, (), (override));
     MOCK_METHOD(game_engine::GameSettings, GetSettings, (), (override));
 };
@@ -80,6 +101,55 @@ protected:
         m_engine = std::make_shared<game_engine::EngineImpl>(create_module_locator());
     }
 
+    /// @brief Loads the meshes asynchronously before the first frame and runs the given number of frames.
+    /// @return The frame each mesh was uploaded in.
+    std::vector<int> UploadMeshes(const game_engine::GameSettings& settings, std::uint32_t meshes_count, std::size_t frames_count)
+    {
+        using namespace testing;
+        using game_engine::graphics::BeginFrameCommand;
+        using game_engine::graphics::RenderHandle;
+
+        std::vector<std::shared_ptr<game_engine::MeshResource>> meshes;
+        for (std::uint32_t i = 0; i < meshes_count; ++i) {
+            meshes.push_back(std::make_shared<game_engine::MeshResource>(i + 1, "mesh"));
+            meshes.back()->SetVertexData({.vertex_count = 1, .vertex_size = 16, .attributes = {}, .data = std::vector<std::byte>(16)});
+        }
+
+        std::atomic<int> frames{0};
+        std::vector<int> upload_frames;
+        std::vector<bool> results;
+
+        EXPECT_CALL(*m_mock_backend, Init(_)).WillOnce(Return(true));
+        EXPECT_CALL(*m_mock_renderer, Init()).WillOnce(Return(true));
+        EXPECT_CALL(*m_mock_game, GetSettings()).WillRepeatedly(Return(settings));
+        EXPECT_CALL(*m_mock_renderer, Load(An<const std::shared_ptr<game_engine::IMesh>&>()))
+            .WillRepeatedly([&](const std::shared_ptr<game_engine::IMesh>&) {
+                upload_frames.push_back(frames.load());
+                return RenderHandle(static_cast<std::uint32_t>(upload_frames.size()), 1);
+            });
+        ON_CALL(*m_mock_renderer, Execute(An<const BeginFrameCommand&>())).WillByDefault([&](const BeginFrameCommand&) {
+            frames++;
+        });
+
+        EXPECT_CALL(*m_mock_game, Init(_)).WillOnce([&](std::shared_ptr<game_engine::IEngine> engine) {
+            auto renderer = engine->GetRenderer();
+            for (const auto& mesh : meshes) {
+                renderer->LoadAsync(mesh, [&](bool loaded) { results.push_back(loaded); });
+            }
+            return true;
+        });
+
+        m_mock_backend.reset();
+        m_mock_renderer.reset();
+        m_mock_game.reset();
+
+        m_engine->EnableBenchmark({.frames = frames_count, .warmup_frames = 0});
+        EXPECT_EQ(m_engine->run(), 0);
+        EXPECT_EQ(results, std::vector<bool>(upload_frames.size(), true));
+
+        return upload_frames;
+    }
+
     std::shared_ptr<MockBackend> m_mock_backend;
     std::shared_ptr<MockRenderer> m_mock_renderer;
     std::shared_ptr<MockGame> m_mock_game;
@@ -145,4 +215,517 @@ TEST_F(EngineFixture, MainLoopExecution)
     runner.join();
 
     EXPECT_TRUE(stop_flag.load());
+
+    const auto stats = m_engine->GetFrameStats();
+    EXPECT_GT(stats[game_engine::FramePhase::PollEvents].samples, 0u);
+    EXPECT_GT(stats[game_engine::FramePhase::Frame].samples, 0u);
+    EXPECT_EQ(stats[game_engine::FramePhase::RenderExecution].samples, stats[game_engine::FramePhase::Submit].samples);
+}
+
+TEST_F(EngineFixture, SimulationThreadOverlapsUpdatesWithDrawing)
+{
+    using namespace testing;
+
+    game_engine::GameSettings settings;
+    settings.threading   = game_engine::ThreadingMode::SimulationThread;
+    settings.update_rate = 240;
+    settings.frame_rate  = 120;
+
+    std::atomic<bool> updating{false};
+    std::atomic<bool> sync_overlapped_update{false};
+    std::atomic<bool> draw_overlapped_update{false};
+    std::atomic<bool> update_after_shutdown{false};
+    std::atomic<bool> shut_down{false};
+    std::atomic<int> updates{0};
+    std::atomic<int> syncs{0};
+
+    std::thread::id update_thread;
+    std::thread::id draw_thread;
+    std::thread::id sync_thread;
+
+    EXPECT_CALL(*m_mock_backend, Init(_)).WillOnce(Return(true));
+    EXPECT_CALL(*m_mock_renderer, Init()).WillOnce(Return(true));
+    EXPECT_CALL(*m_mock_game, Init(_)).WillOnce(Return(true));
+    EXPECT_CALL(*m_mock_game, GetSettings()).WillRepeatedly(Return(settings));
+
+    ON_CALL(*m_mock_game, OnUpdate(_)).WillByDefault([&](std::chrono::nanoseconds) {
+        updating      = true;
+        update_thread = std::this_thread::get_id();
+        if (shut_down) {
+            update_after_shutdown = true;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        updates++;
+        updating = false;
+    });
+    ON_CALL(*m_mock_game, OnSync()).WillByDefault([&] {
+        if (updating) {
+            sync_overlapped_update = true;
+        }
+        sync_thread = std::this_thread::get_id();
+        syncs++;
+    });
+    ON_CALL(*m_mock_game, OnDraw()).WillByDefault([&] {
+        draw_thread = std::this_thread::get_id();
+
+        // The updates are handed to the simulation thread before drawing, give it a moment to start one
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(2);
+        while (!updating && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+
+        if (updating) {
+            draw_overlapped_update = true;
+        }
+    });
+    EXPECT_CALL(*m_mock_game, Shutdown()).WillOnce([&] { shut_down = true; });
+
+    // Free modules in fixture to prevent resource leak errors
+    m_mock_backend.reset();
+    m_mock_renderer.reset();
+    m_mock_game.reset();
+
+    std::thread::id runner_thread;
+    std::thread runner([&] {
+        runner_thread = std::this_thread::get_id();
+        m_engine->run();
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    m_engine->SetShouldStopFlag();
+    runner.join();
+
+    EXPECT_GT(updates.load(), 0);
+    EXPECT_GT(syncs.load(), 0);
+    EXPECT_EQ(draw_thread, runner_thread);
+    EXPECT_EQ(sync_thread, runner_thread);
+    EXPECT_NE(update_thread, runner_thread);
+    EXPECT_NE(update_thread, std::thread::id{});
+    EXPECT_TRUE(draw_overlapped_update.load());
+    EXPECT_FALSE(sync_overlapped_update.load());
+    EXPECT_FALSE(update_after_shutdown.load());
+}
+
+TEST_F(EngineFixture, BenchmarkRunsUnthrottled)
+{
+    using namespace testing;
+
+    game_engine::GameSettings settings;
+    settings.update_rate = 10;
+    settings.frame_rate  = 10;
+
+    EXPECT_CALL(*m_mock_backend, Init(_)).WillOnce(Return(true));
+    EXPECT_CALL(*m_mock_renderer, Init()).WillOnce(Return(true));
+    EXPECT_CALL(*m_mock_game, Init(_)).WillOnce(Return(true));
+    EXPECT_CALL(*m_mock_game, GetSettings()).WillRepeatedly(Return(settings));
+
+    // Warmup and measured frames, at 10 fps they would take 25 seconds
+    EXPECT_CALL(*m_mock_game, OnDraw()).Times(250);
+    EXPECT_CALL(*m_mock_game, OnUpdate(_)).Times(250);
+
+    m_mock_backend.reset();
+    m_mock_renderer.reset();
+    m_mock_game.reset();
+
+    m_engine->EnableBenchmark({.frames = 200, .warmup_frames = 50});
+
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(m_engine->run(), 0);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+
+    const auto& result = m_engine->GetBenchmarkResult();
+    EXPECT_EQ(result.frames, 200u);
+    EXPECT_EQ(result.updates, 200u);
+    EXPECT_GT(result.GetFramesPerSecond(), 10.0);
+    EXPECT_EQ(result.stats[game_engine::FramePhase::Draw].samples, 200u);
+
+    std::ostringstream json;
+    game_engine::WriteBenchmarkJson(json, result);
+    EXPECT_NE(json.str().find("\"frames\": 200,"), std::string::npos);
+    EXPECT_NE(json.str().find("\"draw\": {\"samples\": 200,"), std::string::npos);
+}
+
+TEST_F(EngineFixture, SlowRenderingBlocksSubmission)
+{
+    using namespace testing;
+
+    game_engine::GameSettings settings;
+    settings.max_frames_in_flight = 1;
+    settings.frame_backpressure   = game_engine::FrameBackpressure::Block;
+
+    EXPECT_CALL(*m_mock_backend, Init(_)).WillOnce(Return(true));
+    EXPECT_CALL(*m_mock_renderer, Init()).WillOnce(Return(true));
+    EXPECT_CALL(*m_mock_game, Init(_)).WillOnce(Return(true));
+    EXPECT_CALL(*m_mock_game, GetSettings()).WillRepeatedly(Return(settings));
+    ON_CALL(*m_mock_backend, SwapBuffers()).WillByDefault([] { std::this_thread::sleep_for(std::chrono::milliseconds(2)); });
+
+    m_mock_backend.reset();
+    m_mock_renderer.reset();
+    m_mock_game.reset();
+
+    m_engine->EnableBenchmark({.frames = 20, .warmup_frames = 0});
+    EXPECT_EQ(m_engine->run(), 0);
+
+    // The main loop outpaces the render thread and has to wait for every frame
+    const auto stats = m_engine->GetFrameStats();
+    EXPECT_LE(stats.max_frames_in_flight, 1u);
+    EXPECT_GT(stats[game_engine::FramePhase::Stall].samples, 0u);
+    EXPECT_EQ(stats.skipped_frames, 0u);
+    EXPECT_EQ(stats[game_engine::FramePhase::RenderExecution].samples, 20u);
+}
+
+TEST_F(EngineFixture, SlowRenderingSkipsFrames)
+{
+    using namespace testing;
+
+    game_engine::GameSettings settings;
+    settings.max_frames_in_flight = 1;
+    settings.frame_backpressure   = game_engine::FrameBackpressure::SkipFrame;
+
+    EXPECT_CALL(*m_mock_backend, Init(_)).WillOnce(Return(true));
+    EXPECT_CALL(*m_mock_renderer, Init()).WillOnce(Return(true));
+    EXPECT_CALL(*m_mock_game, Init(_)).WillOnce(Return(true));
+    EXPECT_CALL(*m_mock_game, GetSettings()).WillRepeatedly(Return(settings));
+    ON_CALL(*m_mock_backend, SwapBuffers()).WillByDefault([] { std::this_thread::sleep_for(std::chrono::milliseconds(2)); });
+
+    m_mock_backend.reset();
+    m_mock_renderer.reset();
+    m_mock_game.reset();
+
+    m_engine->EnableBenchmark({.frames = 20, .warmup_frames = 0});
+    EXPECT_EQ(m_engine->run(), 0);
+
+    // Every frame is either rendered or skipped, the main loop never waits
+    const auto stats = m_engine->GetFrameStats();
+    EXPECT_LE(stats.max_frames_in_flight, 1u);
+    EXPECT_GT(stats.skipped_frames, 0u);
+    EXPECT_EQ(stats[game_engine::FramePhase::Stall].samples, 0u);
+    EXPECT_EQ(stats[game_engine::FramePhase::RenderExecution].samples + stats.skipped_frames, 20u);
+}
+
+TEST_F(EngineFixture, RenderCommandsCarryModuleHandles)
+{
+    using namespace testing;
+    using game_engine::graphics::RenderCommand;
+    using game_engine::graphics::RenderHandle;
+
+    const RenderHandle mesh_handle(3, 2);
+    const RenderHandle shader_handle(5, 1);
+
+    auto mesh   = std::make_shared<game_engine::MeshResource>(1, "mesh");
+    auto shader = std::make_shared<game_engine::ShaderResource>(2, "shader");
+
+    std::shared_ptr<game_engine::IRenderer> renderer;
+    std::mutex commands_mutex;
+    std::vector<RenderCommand> commands;
+
+    EXPECT_CALL(*m_mock_backend, Init(_)).WillOnce(Return(true));
+    EXPECT_CALL(*m_mock_renderer, Init()).WillOnce(Return(true));
+
+    // Loading twice reaches the module once
+    EXPECT_CALL(*m_mock_renderer, Load(An<const std::shared_ptr<game_engine::IMesh>&>())).WillOnce(Return(mesh_handle));
+    EXPECT_CALL(*m_mock_renderer, Load(An<const std::shared_ptr<game_engine::IShader>&>())).WillOnce(Return(shader_handle));
+
+    EXPECT_CALL(*m_mock_game, Init(_)).WillOnce([&](std::shared_ptr<game_engine::IEngine> engine) {
+        renderer = engine->GetRenderer();
+        return renderer->Load(mesh) && renderer->Load(shader) && renderer->Load(mesh);
+    });
+    ON_CALL(*m_mock_game, OnDraw()).WillByDefault([&] {
+        renderer->Render(mesh, shader, std::span<const game_engine::PropertyBinding>{}, game_engine::DrawOrder{});
+    });
+    ON_CALL(*m_mock_renderer, Execute(An<const RenderCommand&>())).WillByDefault([&](const RenderCommand& command) {
+        std::lock_guard<std::mutex> lock(commands_mutex);
+        commands.push_back(command);
+    });
+    ON_CALL(*m_mock_renderer, GetDrawCallsCount()).WillByDefault(Return(2));
+    ON_CALL(*m_mock_renderer, GetStateChanges()).WillByDefault(Return(game_engine::graphics::StateChangeStats{.issued = 3, .skipped = 4}));
+
+    m_mock_backend.reset();
+    m_mock_renderer.reset();
+    m_mock_game.reset();
+
+    m_engine->EnableBenchmark({.frames = 5, .warmup_frames = 0});
+    EXPECT_EQ(m_engine->run(), 0);
+    renderer.reset();
+
+    const auto stats = m_engine->GetFrameStats();
+    EXPECT_EQ(stats.draw_calls, 2u);
+    EXPECT_EQ(stats.state_changes, 3u);
+    EXPECT_EQ(stats.skipped_state_changes, 4u);
+
+    ASSERT_FALSE(commands.empty());
+    for (const auto& command : commands) {
+        EXPECT_EQ(command.mesh, mesh_handle);
+        EXPECT_EQ(command.shader, shader_handle);
+    }
+}
+
+TEST_F(EngineFixture, ShaderPropertiesAreValidatedWhenRecorded)
+{
+    using namespace testing;
+    using game_engine::graphics::GetPropertyTypeBit;
+    using game_engine::graphics::PropertyType;
+    using game_engine::graphics::RenderCommand;
+    using game_engine::graphics::RenderHandle;
+    using game_engine::graphics::ShaderProperty;
+
+    const RenderHandle shader_handle(5, 1);
+
+    auto mesh   = std::make_shared<game_engine::MeshResource>(1, "mesh");
+    auto shader = std::make_shared<game_engine::ShaderResource>(2, "shader");
+
+    std::shared_ptr<game_engine::IRenderer> renderer;
+    std::vector<ShaderProperty> resolved;
+    std::mutex commands_mutex;
+    std::vector<RenderCommand> commands;
+
+    EXPECT_CALL(*m_mock_backend, Init(_)).WillOnce(Return(true));
+    EXPECT_CALL(*m_mock_renderer, Init()).WillOnce(Return(true));
+    EXPECT_CALL(*m_mock_renderer, Load(An<const std::shared_ptr<game_engine::IMesh>&>())).WillOnce(Return(RenderHandle(3, 1)));
+    EXPECT_CALL(*m_mock_renderer, Load(An<const std::shared_ptr<game_engine::IShader>&>())).WillOnce(Return(shader_handle));
+
+    // Resolved once when the shader is loaded
+    EXPECT_CALL(*m_mock_renderer, GetShaderProperties(shader_handle))
+        .WillOnce(Return(std::vector<ShaderProperty>{
+            {.name = "color", .accepted_types = GetPropertyTypeBit(PropertyType::Vector4), .id = {}},
+    }));
+    EXPECT_CALL(*m_mock_renderer, ResolveShaderProperties(shader_handle, _))
+        .WillOnce([&](RenderHandle, std::span<const ShaderProperty> properties) {
+            resolved.assign(properties.begin(), properties.end());
+        });
+
+    EXPECT_CALL(*m_mock_game, Init(_)).WillOnce([&](std::shared_ptr<game_engine::IEngine> engine) {
+        renderer = engine->GetRenderer();
+        return renderer->Load(mesh) && renderer->Load(shader);
+    });
+    ON_CALL(*m_mock_game, OnDraw()).WillByDefault([&] {
+        renderer->Render(mesh,
+            shader,
+            {
+                {"color", game_engine::Vector4(1.0f)},
+                {"color_scale", 1.0f},
+        });
+        renderer->Render(mesh, shader, {{"color", 1.0f}});
+    });
+    ON_CALL(*m_mock_renderer, Execute(An<const RenderCommand&>())).WillByDefault([&](const RenderCommand& command) {
+        std::lock_guard<std::mutex> lock(commands_mutex);
+        commands.push_back(command);
+    });
+
+    m_mock_backend.reset();
+    m_mock_renderer.reset();
+    m_mock_game.reset();
+
+    m_engine->EnableBenchmark({.frames = 2, .warmup_frames = 0});
+    EXPECT_EQ(m_engine->run(), 0);
+    renderer.reset();
+
+    ASSERT_EQ(resolved.size(), 1u);
+    EXPECT_EQ(resolved[0].id, game_engine::PropertyId("color"));
+
+    // The unknown property and the mismatched type are dropped before the draws reach the module
+    // Every frame has one draw keeping "color" and one left without properties
+    ASSERT_FALSE(commands.empty());
+    const auto with_color = std::ranges::count_if(commands, [](const auto& command) { return command.properties.count == 1; });
+    const auto without    = std::ranges::count_if(commands, [](const auto& command) { return command.properties.count == 0; });
+    EXPECT_EQ(with_color, without);
+    EXPECT_EQ(static_cast<std::size_t>(with_color + without), commands.size());
+}
+
+TEST_F(EngineFixture, DrawsOfResourcesNotLoadedAreReportedOnce)
+{
+    using namespace testing;
+    using game_engine::graphics::RenderCommand;
+    using game_engine::graphics::RenderHandle;
+
+    auto mesh    = std::make_shared<game_engine::MeshResource>(1, "mesh");
+    auto missing = std::make_shared<game_engine::MeshResource>(2, "missing");
+    auto shader  = std::make_shared<game_engine::ShaderResource>(3, "shader");
+
+    std::shared_ptr<game_engine::IRenderer> renderer;
+    std::atomic<int> draws{0};
+
+    EXPECT_CALL(*m_mock_backend, Init(_)).WillOnce(Return(true));
+    EXPECT_CALL(*m_mock_renderer, Init()).WillOnce(Return(true));
+    EXPECT_CALL(*m_mock_renderer, Load(An<const std::shared_ptr<game_engine::IMesh>&>())).WillOnce(Return(RenderHandle(1, 1)));
+    EXPECT_CALL(*m_mock_renderer, Load(An<const std::shared_ptr<game_engine::IShader>&>())).WillOnce(Return(RenderHandle(2, 1)));
+
+    EXPECT_CALL(*m_mock_game, Init(_)).WillOnce([&](std::shared_ptr<game_engine::IEngine> engine) {
+        renderer = engine->GetRenderer();
+        renderer->LoadAsync(mesh, {});
+        renderer->LoadAsync(shader, {});
+        return true;
+    });
+    ON_CALL(*m_mock_game, OnDraw()).WillByDefault([&] {
+        renderer->Render(mesh, shader, std::vector<game_engine::Property>{});
+        renderer->Render(missing, shader, std::vector<game_engine::Property>{});
+    });
+    ON_CALL(*m_mock_renderer, Execute(An<const RenderCommand&>())).WillByDefault([&](const RenderCommand&) { draws++; });
+
+    m_mock_backend.reset();
+    m_mock_renderer.reset();
+    m_mock_game.reset();
+
+    // The uploads complete in the first frame, its draws find them queued
+    testing::internal::CaptureStderr();
+    m_engine->EnableBenchmark({.frames = 10, .warmup_frames = 0});
+    EXPECT_EQ(m_engine->run(), 0);
+    renderer.reset();
+    const std::string errors = testing::internal::GetCapturedStderr();
+
+    auto count = [&errors](std::string_view text) {
+        std::size_t found = 0;
+        for (auto pos = errors.find(text); pos != std::string::npos; pos = errors.find(text, pos + 1)) {
+            ++found;
+        }
+        return found;
+    };
+
+    EXPECT_EQ(count("'missing' not loaded"), 1u);
+    EXPECT_EQ(count("'mesh' not loaded"), 0u);
+    EXPECT_EQ(count("'shader' not loaded"), 0u);
+    EXPECT_GT(draws.load(), 0);
+}
+
+TEST_F(EngineFixture, ZeroUploadBytesBudgetUploadsOneMeshPerFrame)
+{
+    game_engine::GameSettings settings;
+    settings.upload_bytes_per_frame = 0;
+
+    const auto upload_frames = UploadMeshes(settings, 3, 10);
+
+    ASSERT_EQ(upload_frames.size(), 3u);
+    EXPECT_LT(upload_frames[0], upload_frames[1]);
+    EXPECT_LT(upload_frames[1], upload_frames[2]);
+}
+
+TEST_F(EngineFixture, ZeroUploadTimeBudgetUploadsOneMeshPerFrame)
+{
+    game_engine::GameSettings settings;
+    settings.upload_time_per_frame = std::chrono::microseconds(0);
+
+    const auto upload_frames = UploadMeshes(settings, 3, 10);
+
+    ASSERT_EQ(upload_frames.size(), 3u);
+    EXPECT_LT(upload_frames[0], upload_frames[1]);
+    EXPECT_LT(upload_frames[1], upload_frames[2]);
+}
+
+TEST_F(EngineFixture, LoadAsyncDoesNotBlockOnFullUploadLane)
+{
+    using namespace testing;
+    using game_engine::graphics::RenderHandle;
+
+    // The budget runs out before the first frame, then more than the 256 task slots of a lane are left to queue
+    constexpr std::uint32_t Meshes         = 400;
+    constexpr std::uint32_t MeshesPerFrame = 100;
+
+    game_engine::GameSettings settings;
+    settings.upload_bytes_per_frame = MeshesPerFrame * 16;
+    settings.upload_time_per_frame  = std::chrono::seconds(1);
+
+    std::vector<std::shared_ptr<game_engine::MeshResource>> meshes;
+    for (std::uint32_t i = 0; i < Meshes; ++i) {
+        meshes.push_back(std::make_shared<game_engine::MeshResource>(i + 1, "mesh"));
+        meshes.back()->SetVertexData({.vertex_count = 1, .vertex_size = 16, .attributes = {}, .data = std::vector<std::byte>(16)});
+    }
+
+    std::atomic<std::uint32_t> loads{0};
+    std::vector<bool> results;
+
+    EXPECT_CALL(*m_mock_backend, Init(_)).WillOnce(Return(true));
+    EXPECT_CALL(*m_mock_renderer, Init()).WillOnce(Return(true));
+    EXPECT_CALL(*m_mock_game, GetSettings()).WillRepeatedly(Return(settings));
+    EXPECT_CALL(*m_mock_renderer, Load(An<const std::shared_ptr<game_engine::IMesh>&>()))
+        .Times(Meshes)
+        .WillRepeatedly([&](const std::shared_ptr<game_engine::IMesh>&) { return RenderHandle(++loads, 1); });
+
+    EXPECT_CALL(*m_mock_game, Init(_)).WillOnce([&](std::shared_ptr<game_engine::IEngine> engine) {
+        auto renderer = engine->GetRenderer();
+        for (const auto& mesh : meshes) {
+            renderer->LoadAsync(mesh, [&](bool loaded) { results.push_back(loaded); });
+        }
+        return true;
+    });
+
+    m_mock_backend.reset();
+    m_mock_renderer.reset();
+    m_mock_game.reset();
+
+    m_engine->EnableBenchmark({.frames = 10, .warmup_frames = 0});
+    EXPECT_EQ(m_engine->run(), 0);
+
+    EXPECT_EQ(loads.load(), Meshes);
+    EXPECT_EQ(results, std::vector<bool>(Meshes, true));
+}
+
+TEST_F(EngineFixture, LoadAsyncSpreadsUploadsOverFrames)
+{
+    using namespace testing;
+    using game_engine::graphics::BeginFrameCommand;
+    using game_engine::graphics::RenderHandle;
+
+    constexpr std::uint32_t Meshes = 3;
+
+    // Every mesh exceeds the budget, so one is uploaded per frame
+    game_engine::GameSettings settings;
+    settings.upload_bytes_per_frame = 1;
+
+    std::vector<std::shared_ptr<game_engine::MeshResource>> meshes;
+    for (std::uint32_t i = 0; i < Meshes; ++i) {
+        meshes.push_back(std::make_shared<game_engine::MeshResource>(i + 1, "mesh"));
+        meshes.back()->SetVertexData({.vertex_count = 1, .vertex_size = 16, .attributes = {}, .data = std::vector<std::byte>(16)});
+    }
+
+    std::atomic<int> frames{0};
+    std::vector<int> upload_frames;
+    std::vector<bool> results;
+    std::thread::id callback_thread;
+
+    EXPECT_CALL(*m_mock_backend, Init(_)).WillOnce(Return(true));
+    EXPECT_CALL(*m_mock_renderer, Init()).WillOnce(Return(true));
+    EXPECT_CALL(*m_mock_game, GetSettings()).WillRepeatedly(Return(settings));
+    EXPECT_CALL(*m_mock_renderer, Load(An<const std::shared_ptr<game_engine::IMesh>&>()))
+        .Times(Meshes)
+        .WillRepeatedly([&](const std::shared_ptr<game_engine::IMesh>&) {
+            upload_frames.push_back(frames.load());
+            return RenderHandle(static_cast<std::uint32_t>(upload_frames.size()), 1);
+        });
+    ON_CALL(*m_mock_renderer, Execute(An<const BeginFrameCommand&>())).WillByDefault([&](const BeginFrameCommand&) {
+        frames++;
+    });
+
+    EXPECT_CALL(*m_mock_game, Init(_)).WillOnce([&](std::shared_ptr<game_engine::IEngine> engine) {
+        auto renderer = engine->GetRenderer();
+        for (const auto& mesh : meshes) {
+            renderer->LoadAsync(mesh, [&](bool loaded) {
+                results.push_back(loaded);
+                callback_thread = std::this_thread::get_id();
+            });
+        }
+        return true;
+    });
+
+    m_mock_backend.reset();
+    m_mock_renderer.reset();
+    m_mock_game.reset();
+
+    m_engine->EnableBenchmark({.frames = 10, .warmup_frames = 0});
+    EXPECT_EQ(m_engine->run(), 0);
+
+    ASSERT_EQ(upload_frames.size(), Meshes);
+    EXPECT_LT(upload_frames[0], upload_frames[1]);
+    EXPECT_LT(upload_frames[1], upload_frames[2]);
+
+    EXPECT_EQ(results, std::vector<bool>(Meshes, true));
+    EXPECT_EQ(callback_thread, std::this_thread::get_id());
+    for (const auto& mesh : meshes) {
+        EXPECT_EQ(mesh->GetState(), game_engine::ResourceState::LoadedInGPU);
+    }
+
+    const auto stats = m_engine->GetFrameStats();
+    EXPECT_EQ(stats[game_engine::FramePhase::Upload].samples, Meshes);
+    EXPECT_EQ(stats[game_engine::RenderLane::Background].samples, Meshes);
+    EXPECT_GT(stats[game_engine::RenderLane::Frame].samples, 0u);
 }
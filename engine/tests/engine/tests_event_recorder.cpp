@@ -0,0 +1,97 @@
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include <events/event_recorder.hpp>
+#include <modules/backend/event_record.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace
+{
+
+class RecordedEventsCollector
+{
+public:
+
+    void operator()(const game_engine::KeyboardInputEvent& event)
+    {
+        keys.push_back(event.key);
+    }
+
+    void operator()(const game_engine::WindowResizeEvent& event)
+    {
+        widths.push_back(event.width);
+    }
+
+    template <typename TEvent>
+    void operator()(const TEvent&)
+    {
+        others++;
+    }
+
+    std::vector<game_engine::KeyCode> keys;
+    std::vector<int> widths;
+    int others = 0;
+};
+
+} // namespace
+
+TEST(EventRecorderTest, RecordsAreReadBackWithFrames)
+{
+    using namespace game_engine;
+
+    const auto file = std::filesystem::temp_directory_path() / "engine_event_recorder_test.bin";
+
+    {
+        EventRecorder recorder;
+        ASSERT_TRUE(recorder.Open(file));
+
+        recorder.NextFrame();
+        recorder.OnEvent(KeyboardInputEvent{KeyCode::Escape, KeyAction::Press, KeyModifier::Shift});
+        recorder.OnEvent(WindowResizeEvent{800, 600});
+
+        recorder.NextFrame();
+        recorder.NextFrame();
+        recorder.OnEvent(WindowCloseEvent{});
+
+        EXPECT_EQ(recorder.GetRecordsCount(), 3u);
+    }
+
+    std::ifstream stream(file, std::ios::binary);
+    ASSERT_TRUE(backend::ReadEventRecordHeader(stream));
+
+    std::vector<backend::EventRecord> records;
+    backend::EventRecord record;
+    while (backend::ReadEventRecord(stream, record)) {
+        records.push_back(record);
+    }
+
+    ASSERT_EQ(records.size(), 3u);
+    EXPECT_EQ(records[0].frame, 0u);
+    EXPECT_EQ(records[1].frame, 0u);
+    EXPECT_EQ(records[2].frame, 2u);
+    EXPECT_LE(records[0].timestamp, records[2].timestamp);
+
+    RecordedEventsCollector collector;
+    for (const auto& r : records) {
+        backend::VisitEventRecord(r, collector);
+    }
+
+    EXPECT_THAT(collector.keys, ::testing::ElementsAre(KeyCode::Escape));
+    EXPECT_THAT(collector.widths, ::testing::ElementsAre(800));
+    EXPECT_EQ(collector.others, 1);
+
+    stream.close();
+    std::filesystem::remove(file);
+}
+
+TEST(EventRecorderTest, ClosedRecorderIgnoresEvents)
+{
+    game_engine::EventRecorder recorder;
+    recorder.OnEvent(game_engine::WindowCloseEvent{});
+
+    EXPECT_FALSE(recorder.IsOpen());
+    EXPECT_EQ(recorder.GetRecordsCount(), 0u);
+}
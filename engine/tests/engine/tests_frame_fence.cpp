@@ -0,0 +1,42 @@
+#include <atomic>
+#include <thread>
+
+#include <graphics/frame_fence.hpp>
+
+#include <gtest/gtest.h>
+
+TEST(FrameFenceTest, WaitReturnsForCompletedFrames)
+{
+    game_engine::FrameFence fence;
+    EXPECT_EQ(fence.GetCompletedFrame(), 0u);
+
+    fence.Wait(0);
+
+    fence.Signal(3);
+    fence.Wait(1);
+    fence.Wait(3);
+    EXPECT_EQ(fence.GetCompletedFrame(), 3u);
+}
+
+TEST(FrameFenceTest, WaitBlocksUntilSignaled)
+{
+    constexpr std::uint64_t Frames = 1000;
+
+    game_engine::FrameFence fence;
+    std::atomic<std::uint64_t> signaled = 0;
+
+    std::thread render_thread([&] {
+        for (std::uint64_t frame = 1; frame <= Frames; ++frame) {
+            signaled.store(frame, std::memory_order_relaxed);
+            fence.Signal(frame);
+        }
+    });
+
+    for (std::uint64_t frame = 1; frame <= Frames; frame += 7) {
+        fence.Wait(frame);
+        EXPECT_GE(signaled.load(std::memory_order_relaxed), frame);
+    }
+
+    render_thread.join();
+    EXPECT_EQ(fence.GetCompletedFrame(), Frames);
+}
@@ -0,0 +1,32 @@
+#include <chrono>
+
+#include <frame_pacer.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+TEST(FramePacerTest, WaitsUntilDeadline)
+{
+    using game_engine::FramePacer;
+
+    for (auto pacing : {game_engine::FramePacing::LowLatency, game_engine::FramePacing::LowPower}) {
+        FramePacer pacer(pacing, 1ms);
+
+        const auto deadline = FramePacer::Clock::now() + 5ms;
+        pacer.WaitUntil(deadline);
+
+        EXPECT_GE(FramePacer::Clock::now(), deadline);
+        EXPECT_EQ(pacer.GetStats().waits, 1u);
+        EXPECT_GE(pacer.GetStats().last_jitter, 0ns);
+        EXPECT_EQ(pacer.GetStats().max_jitter, pacer.GetStats().last_jitter);
+    }
+}
+
+TEST(FramePacerTest, PassedDeadlineReturnsAtOnce)
+{
+    game_engine::FramePacer pacer;
+    pacer.WaitUntil(game_engine::FramePacer::Clock::now() - 1ms);
+
+    EXPECT_EQ(pacer.GetStats().waits, 0u);
+}
@@ -0,0 +1,128 @@
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <frame_stats_collector.hpp>
+#include <latency_histogram.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+TEST(LatencyHistogramTest, EmptyHistogram)
+{
+    game_engine::LatencyHistogram histogram;
+
+    const auto timings = histogram.GetTimings();
+    EXPECT_EQ(timings.samples, 0u);
+    EXPECT_EQ(timings.max, 0ns);
+    EXPECT_EQ(timings.p99, 0ns);
+}
+
+TEST(LatencyHistogramTest, Summary)
+{
+    game_engine::LatencyHistogram histogram;
+
+    // 1..1000 microseconds
+    for (int i = 1; i <= 1000; ++i) {
+        histogram.Record(std::chrono::microseconds(i));
+    }
+
+    const auto timings = histogram.GetTimings();
+    EXPECT_EQ(timings.samples, 1000u);
+    EXPECT_EQ(timings.min, 1us);
+    EXPECT_EQ(timings.max, 1000us);
+    EXPECT_EQ(timings.average, 500500ns);
+    EXPECT_GE(timings.p50, 500us);
+    EXPECT_LE(timings.p50, 500us + 500us / 8);
+    EXPECT_GE(timings.p90, 900us);
+    EXPECT_LE(timings.p90, 900us + 900us / 8);
+
+    // The bucket width is at most 1/8 of the value
+    EXPECT_GE(timings.p99, 990us);
+    EXPECT_LE(timings.p99, 1000us);
+}
+
+TEST(LatencyHistogramTest, P99IgnoresRareSpikes)
+{
+    game_engine::LatencyHistogram histogram;
+
+    for (int i = 0; i < 995; ++i) {
+        histogram.Record(2ms);
+    }
+    for (int i = 0; i < 5; ++i) {
+        histogram.Record(50ms);
+    }
+
+    const auto timings = histogram.GetTimings();
+    EXPECT_EQ(timings.max, 50ms);
+    EXPECT_GE(timings.p99, 2ms);
+    EXPECT_LE(timings.p99, 2250us);
+}
+
+TEST(LatencyHistogramTest, RotationDropsOldSamples)
+{
+    game_engine::LatencyHistogram histogram;
+
+    histogram.Record(10ms);
+    histogram.Rotate();
+    histogram.Record(1ms);
+
+    // Both windows are reported
+    EXPECT_EQ(histogram.GetTimings().samples, 2u);
+    EXPECT_EQ(histogram.GetTimings().max, 10ms);
+
+    histogram.Rotate();
+
+    EXPECT_EQ(histogram.GetTimings().samples, 1u);
+    EXPECT_EQ(histogram.GetTimings().max, 1ms);
+
+    histogram.Rotate();
+
+    EXPECT_EQ(histogram.GetTimings().samples, 0u);
+}
+
+TEST(LatencyHistogramTest, ConcurrentRecords)
+{
+    game_engine::LatencyHistogram histogram;
+
+    constexpr int Threads = 4;
+    constexpr int Samples = 10000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < Threads; ++t) {
+        threads.emplace_back([&histogram, t] {
+            for (int i = 0; i < Samples; ++i) {
+                histogram.Record(std::chrono::microseconds(t + 1));
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const auto timings = histogram.GetTimings();
+    EXPECT_EQ(timings.samples, static_cast<std::uint64_t>(Threads * Samples));
+    EXPECT_EQ(timings.min, 1us);
+    EXPECT_EQ(timings.max, std::chrono::microseconds(Threads));
+}
+
+TEST(FrameStatsCollectorTest, ScopedTimerRecordsPhase)
+{
+    using game_engine::FramePhase;
+
+    game_engine::FrameStatsCollector collector;
+    {
+        game_engine::FrameStatsCollector::ScopedTimer timer(collector, FramePhase::Draw);
+        std::this_thread::sleep_for(1ms);
+    }
+    collector.Rotate(60, 30);
+
+    const auto stats = collector.GetStats();
+    EXPECT_EQ(stats[FramePhase::Draw].samples, 1u);
+    EXPECT_GE(stats[FramePhase::Draw].min, 1ms);
+    EXPECT_EQ(stats[FramePhase::Update].samples, 0u);
+    EXPECT_EQ(stats.updates_per_second, 60u);
+    EXPECT_EQ(stats.frames_per_second, 30u);
+}
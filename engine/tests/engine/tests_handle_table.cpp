@@ -0,0 +1,76 @@
+#include <cstdint>
+#include <string>
+
+#include <modules/graphics/handle_table.hpp>
+
+#include <gtest/gtest.h>
+
+using game_engine::graphics::HandleTable;
+using game_engine::graphics::RenderHandle;
+
+TEST(HandleTableTest, InsertAndGet)
+{
+    HandleTable<std::string> table;
+
+    const RenderHandle first  = table.Insert("first");
+    const RenderHandle second = table.Insert("second");
+
+    EXPECT_TRUE(first.IsValid());
+    EXPECT_TRUE(second.IsValid());
+    EXPECT_NE(first, second);
+    EXPECT_EQ(table.GetSize(), 2u);
+
+    ASSERT_NE(table.Get(first), nullptr);
+    ASSERT_NE(table.Get(second), nullptr);
+    EXPECT_EQ(*table.Get(first), "first");
+    EXPECT_EQ(*table.Get(second), "second");
+
+    EXPECT_FALSE(table.Contains(RenderHandle{}));
+    EXPECT_EQ(table.Get(RenderHandle{}), nullptr);
+    EXPECT_EQ(table.Get(RenderHandle(100, 1)), nullptr);
+}
+
+TEST(HandleTableTest, StaleHandlesAreDetected)
+{
+    HandleTable<std::string> table;
+
+    const RenderHandle old_handle = table.Insert("old");
+    EXPECT_TRUE(table.Erase(old_handle));
+    EXPECT_FALSE(table.Erase(old_handle));
+
+    // The slot is reused with a new generation
+    const RenderHandle new_handle = table.Insert("new");
+    EXPECT_EQ(new_handle.GetIndex(), old_handle.GetIndex());
+    EXPECT_NE(new_handle.GetGeneration(), old_handle.GetGeneration());
+
+    EXPECT_FALSE(table.Contains(old_handle));
+    EXPECT_EQ(table.Get(old_handle), nullptr);
+    ASSERT_NE(table.Get(new_handle), nullptr);
+    EXPECT_EQ(*table.Get(new_handle), "new");
+
+    table.Clear();
+    EXPECT_EQ(table.GetSize(), 0u);
+    EXPECT_EQ(table.Get(new_handle), nullptr);
+}
+
+TEST(HandleTableTest, ExhaustedSlotsAreRetired)
+{
+    HandleTable<int> table;
+
+    RenderHandle handle = table.Insert(0);
+    const std::uint32_t index = handle.GetIndex();
+
+    for (std::uint32_t i = 1; i < RenderHandle::MaxGeneration; ++i) {
+        ASSERT_TRUE(table.Erase(handle));
+        handle = table.Insert(static_cast<int>(i));
+        ASSERT_EQ(handle.GetIndex(), index);
+    }
+
+    // The last generation isn't reused, old handles can't come back to life
+    EXPECT_EQ(handle.GetGeneration(), RenderHandle::MaxGeneration);
+    EXPECT_TRUE(table.Erase(handle));
+
+    const RenderHandle next = table.Insert(-1);
+    EXPECT_NE(next.GetIndex(), index);
+    EXPECT_EQ(next.GetGeneration(), 1u);
+}
@@ -0,0 +1,124 @@
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include <graphics/instance_batcher.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+using game_engine::Matrix4;
+using game_engine::PropertyBinding;
+using game_engine::PropertyId;
+using game_engine::Vector4;
+using game_engine::graphics::PropertyBuffer;
+using game_engine::graphics::RenderCommand;
+using game_engine::graphics::RenderHandle;
+
+RenderCommand MakeDraw(PropertyBuffer& properties, std::uint32_t mesh, float x, Vector4 color = Vector4(1.0f))
+{
+    Matrix4 model(1.0f);
+    model[3][0] = x;
+
+    const std::array<PropertyBinding, 2> bindings = {
+        PropertyBinding{PropertyId("model"), model},
+        PropertyBinding{PropertyId("color"), color},
+    };
+
+    return RenderCommand{
+        .mesh       = RenderHandle(mesh, 1),
+        .shader     = RenderHandle(1, 1),
+        .properties = properties.Append(bindings),
+    };
+}
+
+std::vector<std::uint32_t> Identity(std::size_t count)
+{
+    std::vector<std::uint32_t> order(count);
+    std::iota(order.begin(), order.end(), 0u);
+    return order;
+}
+
+} // namespace
+
+TEST(InstanceBatcherTest, MergesRunsOfIdenticalDraws)
+{
+    PropertyBuffer properties;
+    std::vector<RenderCommand> commands = {
+        MakeDraw(properties, 1, 0.0f),
+        MakeDraw(properties, 1, 1.0f),
+        MakeDraw(properties, 1, 2.0f),
+        MakeDraw(properties, 2, 3.0f),
+    };
+    const auto order = Identity(commands.size());
+
+    game_engine::InstanceBatcher batcher;
+    const auto draws = batcher.Batch(commands, properties, order);
+
+    ASSERT_EQ(std::vector<std::uint32_t>(draws.begin(), draws.end()), (std::vector<std::uint32_t>{0, 3}));
+
+    // The instanced command keeps the shared properties only
+    EXPECT_EQ(commands[0].instance_count, 3u);
+    EXPECT_EQ(commands[0].first_instance, 0u);
+    ASSERT_EQ(commands[0].properties.count, 1u);
+    EXPECT_EQ(properties.Get(commands[0].properties)[0].id, PropertyId("color"));
+
+    EXPECT_EQ(commands[3].instance_count, 1u);
+    EXPECT_EQ(commands[3].properties.count, 2u);
+
+    const auto transforms = batcher.GetInstanceTransforms();
+    ASSERT_EQ(transforms.size(), 3u);
+    EXPECT_EQ(transforms[0][3][0], 0.0f);
+    EXPECT_EQ(transforms[1][3][0], 1.0f);
+    EXPECT_EQ(transforms[2][3][0], 2.0f);
+}
+
+TEST(InstanceBatcherTest, DifferentPropertiesAreNotMerged)
+{
+    PropertyBuffer properties;
+    std::vector<RenderCommand> commands = {
+        MakeDraw(properties, 1, 0.0f, Vector4(1.0f)),
+        MakeDraw(properties, 1, 1.0f, Vector4(0.5f)),
+        MakeDraw(properties, 1, 2.0f, Vector4(0.5f)),
+    };
+
+    const std::array<PropertyBinding, 1> color_only = {PropertyBinding{PropertyId("color"), Vector4(0.5f)}};
+    commands.push_back({.mesh = RenderHandle(1, 1), .shader = RenderHandle(1, 1), .properties = properties.Append(color_only)});
+
+    const auto order = Identity(commands.size());
+
+    game_engine::InstanceBatcher batcher;
+    const auto draws = batcher.Batch(commands, properties, order);
+
+    // Only the two draws with the same color merge, the draw without a transform stays alone
+    EXPECT_EQ(std::vector<std::uint32_t>(draws.begin(), draws.end()), (std::vector<std::uint32_t>{0, 1, 3}));
+    EXPECT_EQ(commands[1].instance_count, 2u);
+    EXPECT_EQ(batcher.GetInstanceTransforms().size(), 2u);
+}
+
+TEST(InstanceBatcherTest, FollowsExecutionOrder)
+{
+    PropertyBuffer properties;
+    std::vector<RenderCommand> commands = {
+        MakeDraw(properties, 1, 0.0f),
+        MakeDraw(properties, 2, 1.0f),
+        MakeDraw(properties, 1, 2.0f),
+    };
+    const std::vector<std::uint32_t> order = {0, 2, 1};
+
+    game_engine::InstanceBatcher batcher;
+    const auto draws = batcher.Batch(commands, properties, order);
+
+    EXPECT_EQ(std::vector<std::uint32_t>(draws.begin(), draws.end()), (std::vector<std::uint32_t>{0, 1}));
+    EXPECT_EQ(commands[0].instance_count, 2u);
+    EXPECT_EQ(batcher.GetInstanceTransforms()[1][3][0], 2.0f);
+
+    // Buffers are cleared between frames
+    PropertyBuffer next_properties;
+    std::vector<RenderCommand> next = {MakeDraw(next_properties, 3, 0.0f)};
+    EXPECT_EQ(batcher.Batch(next, next_properties, Identity(1)).size(), 1u);
+    EXPECT_TRUE(batcher.GetInstanceTransforms().empty());
+}
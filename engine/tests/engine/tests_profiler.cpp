@@ -0,0 +1,68 @@
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <engine/utils/profiler.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+std::size_t CountOccurrences(const std::string& text, const std::string& pattern)
+{
+    std::size_t count = 0;
+    for (auto pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + pattern.size())) {
+        ++count;
+    }
+    return count;
+}
+
+} // namespace
+
+TEST(ProfilerTest, WritesZonesOfAllThreads)
+{
+    using namespace game_engine::profiler;
+
+    {
+        ScopedZone zone("ProfilerTest::Outer");
+        ScopedZone inner("ProfilerTest::Inner");
+    }
+
+    std::thread worker([] {
+        SetThreadName("ProfilerTest \"Worker\"");
+        ScopedZone zone("ProfilerTest::Worker");
+    });
+    worker.join();
+
+    std::ostringstream stream;
+    WriteChromeTrace(stream);
+    const std::string trace = stream.str();
+
+    EXPECT_EQ(trace.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["), 0u);
+    EXPECT_EQ(CountOccurrences(trace, "\"name\":\"ProfilerTest::Outer\",\"ph\":\"X\""), 1u);
+    EXPECT_EQ(CountOccurrences(trace, "\"name\":\"ProfilerTest::Inner\",\"ph\":\"X\""), 1u);
+    EXPECT_EQ(CountOccurrences(trace, "\"name\":\"ProfilerTest::Worker\",\"ph\":\"X\""), 1u);
+    EXPECT_NE(trace.find("\"args\":{\"name\":\"ProfilerTest \\\"Worker\\\"\"}"), std::string::npos);
+    EXPECT_EQ(GetDroppedZonesCount(), 0u);
+}
+
+TEST(ProfilerTest, ZoneMacroFollowsCompileTimeSwitch)
+{
+    std::size_t before = 0;
+    {
+        std::ostringstream stream;
+        game_engine::profiler::WriteChromeTrace(stream);
+        before = CountOccurrences(stream.str(), "ProfilerTest::Macro");
+    }
+
+    {
+        PROFILE_ZONE("ProfilerTest::Macro");
+    }
+
+    std::ostringstream stream;
+    game_engine::profiler::WriteChromeTrace(stream);
+
+    const std::size_t expected = game_engine::profiler::Enabled ? 1 : 0;
+    EXPECT_EQ(CountOccurrences(stream.str(), "ProfilerTest::Macro") - before, expected);
+}
@@ -0,0 +1,89 @@
+#include <array>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <engine/graphics/property.hpp>
+
+#include <modules/graphics/property_buffer.hpp>
+
+#include <gtest/gtest.h>
+
+using game_engine::PropertyBinding;
+using game_engine::PropertyId;
+using game_engine::graphics::PropertyType;
+
+TEST(PropertyIdTest, EqualNamesGiveEqualIds)
+{
+    const PropertyId model("model");
+    const PropertyId view("view");
+
+    EXPECT_EQ(model, PropertyId(std::string("mo") + "del"));
+    EXPECT_NE(model, view);
+    EXPECT_STREQ(model.GetName(), "model");
+
+    EXPECT_EQ(PropertyId().GetIndex(), 0u);
+    EXPECT_GT(model.GetIndex(), 0u);
+}
+
+TEST(PropertyIdTest, InterningFromManyThreads)
+{
+    constexpr int Threads = 4;
+
+    std::vector<std::uint32_t> indices(Threads);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < Threads; ++i) {
+        threads.emplace_back([&indices, i] {
+            for (int n = 0; n < 100; ++n) {
+                PropertyId("thread_property_" + std::to_string(n));
+            }
+            indices[static_cast<std::size_t>(i)] = PropertyId("thread_property_42").GetIndex();
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (const auto index : indices) {
+        EXPECT_EQ(index, indices[0]);
+    }
+}
+
+TEST(PropertyBufferTest, PacksValues)
+{
+    game_engine::graphics::PropertyBuffer buffer;
+
+    const std::array<PropertyBinding, 3> first = {
+        PropertyBinding{PropertyId("count"), 7},
+        PropertyBinding{PropertyId("color"), game_engine::Vector4(0.5f)},
+        PropertyBinding{PropertyId("albedo"), std::shared_ptr<game_engine::ITexture>()},
+    };
+    const std::array<PropertyBinding, 1> second = {PropertyBinding{PropertyId("scale"), 2.0f}};
+
+    const auto first_range  = buffer.Append(first);
+    const auto second_range = buffer.Append(second);
+
+    EXPECT_EQ(first_range.first, 0u);
+    EXPECT_EQ(first_range.count, 3u);
+    EXPECT_EQ(second_range.first, 3u);
+    EXPECT_EQ(second_range.count, 1u);
+
+    const auto packed = buffer.Get(first_range);
+    EXPECT_EQ(packed[0].type, PropertyType::Int);
+    EXPECT_EQ(buffer.GetValue<int>(packed[0]), 7);
+    EXPECT_EQ(packed[1].type, PropertyType::Vector4);
+    EXPECT_EQ(packed[1].size, sizeof(game_engine::Vector4));
+    EXPECT_EQ(packed[2].type, PropertyType::Texture);
+    EXPECT_EQ(buffer.GetValue<game_engine::ResourceId>(packed[2]), 0u);
+
+    const auto& scale = buffer.Get(second_range)[0];
+    EXPECT_EQ(scale.id, PropertyId("scale"));
+    EXPECT_EQ(buffer.GetValue<float>(scale), 2.0f);
+
+    EXPECT_EQ(buffer.GetDataSize(), sizeof(int) + sizeof(game_engine::Vector4) + sizeof(game_engine::ResourceId) + sizeof(float));
+
+    buffer.Clear();
+    EXPECT_EQ(buffer.GetPropertiesCount(), 0u);
+    EXPECT_EQ(buffer.GetDataSize(), 0u);
+}
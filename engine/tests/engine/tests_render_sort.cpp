@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <graphics/render_sort.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+using game_engine::DrawOrder;
+using game_engine::graphics::RenderHandle;
+using game_engine::RenderPass;
+using game_engine::TransparentSorting;
+
+std::vector<game_engine::graphics::RenderCommand> MakeCommands(const std::vector<std::uint64_t>& keys)
+{
+    std::vector<game_engine::graphics::RenderCommand> commands(keys.size());
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        commands[i].sort_key = keys[i];
+    }
+
+    return commands;
+}
+
+} // namespace
+
+TEST(RenderSortTest, OpaqueKeysGroupByShaderThenMeshThenDepth)
+{
+    constexpr auto Sorting = TransparentSorting::SubmissionOrder;
+
+    const auto near_a = game_engine::MakeSortKey({.depth = 1.0f}, RenderHandle(1, 1), RenderHandle(1, 1), Sorting);
+    const auto far_a  = game_engine::MakeSortKey({.depth = 100.0f}, RenderHandle(1, 1), RenderHandle(1, 1), Sorting);
+    const auto mesh_b = game_engine::MakeSortKey({.depth = 0.5f}, RenderHandle(1, 1), RenderHandle(2, 1), Sorting);
+    const auto shader = game_engine::MakeSortKey({.depth = 0.0f}, RenderHandle(2, 1), RenderHandle(1, 1), Sorting);
+
+    EXPECT_LT(near_a, far_a);
+    EXPECT_LT(far_a, mesh_b);
+    EXPECT_LT(mesh_b, shader);
+}
+
+TEST(RenderSortTest, DifferentHandlesNeverShareKeys)
+{
+    constexpr auto Sorting = TransparentSorting::BackToFront;
+
+    // Indices equal in their low 16 bits, and the same index with another generation
+    const RenderHandle low(1, 1);
+    const RenderHandle high(0x10001, 1);
+    const RenderHandle reused(1, 2);
+
+    EXPECT_NE(game_engine::MakeSortKey({}, low, low, Sorting), game_engine::MakeSortKey({}, high, low, Sorting));
+    EXPECT_NE(game_engine::MakeSortKey({}, low, low, Sorting), game_engine::MakeSortKey({}, low, high, Sorting));
+    EXPECT_EQ(game_engine::MakeSortKey({}, low, low, Sorting), game_engine::MakeSortKey({}, reused, reused, Sorting));
+
+    const DrawOrder transparent{.pass = RenderPass::Transparent, .depth = 1.0f};
+    EXPECT_NE(game_engine::MakeSortKey(transparent, low, low, Sorting), game_engine::MakeSortKey(transparent, high, low, Sorting));
+    EXPECT_NE(game_engine::MakeSortKey(transparent, low, low, Sorting), game_engine::MakeSortKey(transparent, low, high, Sorting));
+}
+
+TEST(RenderSortTest, TransparentKeysFollowOpaqueKeys)
+{
+    const DrawOrder transparent{.pass = RenderPass::Transparent};
+    const RenderHandle first(0, 1);
+    const RenderHandle last(RenderHandle::MaxIndex, 1);
+
+    const auto opaque = game_engine::MakeSortKey({.depth = 1e30f}, last, last, TransparentSorting::SubmissionOrder);
+    EXPECT_LT(opaque, game_engine::MakeSortKey(transparent, first, first, TransparentSorting::SubmissionOrder));
+    EXPECT_LT(opaque, game_engine::MakeSortKey(transparent, first, first, TransparentSorting::BackToFront));
+
+    // Submission order ignores the state and depth, the stable sort keeps the calls order
+    EXPECT_EQ(game_engine::MakeSortKey({.pass = RenderPass::Transparent, .depth = 5.0f}, first, last, TransparentSorting::SubmissionOrder),
+              game_engine::MakeSortKey(transparent, last, first, TransparentSorting::SubmissionOrder));
+}
+
+TEST(RenderSortTest, TransparentBackToFront)
+{
+    constexpr auto Sorting = TransparentSorting::BackToFront;
+
+    const RenderHandle first(1, 1);
+    const RenderHandle second(2, 1);
+
+    const auto near = game_engine::MakeSortKey({.pass = RenderPass::Transparent, .depth = 1.0f}, first, first, Sorting);
+    const auto far  = game_engine::MakeSortKey({.pass = RenderPass::Transparent, .depth = 10.0f}, second, second, Sorting);
+
+    EXPECT_LT(far, near);
+}
+
+TEST(RenderSortTest, SortIsStable)
+{
+    const auto commands = MakeCommands({3, 1, 2, 1, 3, 0, 1});
+
+    game_engine::RenderCommandSorter sorter;
+    const auto order = sorter.Sort(commands);
+
+    EXPECT_EQ(std::vector<std::uint32_t>(order.begin(), order.end()), (std::vector<std::uint32_t>{5, 1, 3, 6, 2, 0, 4}));
+}
+
+TEST(RenderSortTest, MatchesStableSort)
+{
+    std::mt19937_64 random(42);
+
+    std::vector<std::uint64_t> keys(5000);
+    for (auto& key : keys) {
+        // Few distinct values in some bytes, so digits are both skipped and sorted
+        key = random() & 0xFF00'0000'FFFF'0F0Full;
+    }
+
+    std::vector<std::uint32_t> expected(keys.size());
+    for (std::uint32_t i = 0; i < expected.size(); ++i) {
+        expected[i] = i;
+    }
+    std::ranges::stable_sort(expected, [&](std::uint32_t lhs, std::uint32_t rhs) { return keys[lhs] < keys[rhs]; });
+
+    game_engine::RenderCommandSorter sorter;
+    const auto commands = MakeCommands(keys);
+
+    // The second run reuses the buffers of the first one
+    for (int run = 0; run < 2; ++run) {
+        const auto order = sorter.Sort(commands);
+        ASSERT_EQ(std::vector<std::uint32_t>(order.begin(), order.end()), expected);
+    }
+
+    EXPECT_TRUE(sorter.Sort({}).empty());
+}
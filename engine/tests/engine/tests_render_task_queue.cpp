@@ -0,0 +1,128 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <graphics/render_task_queue.hpp>
+
+#include <gtest/gtest.h>
+
+using game_engine::RenderLane;
+using game_engine::RenderTaskQueue;
+
+TEST(RenderTaskQueueTest, RunsTasksInOrder)
+{
+    RenderTaskQueue queue(4);
+
+    std::vector<int> order;
+    for (int i = 0; i < 3; ++i) {
+        queue.Push(RenderLane::Frame, [&order, i] { order.push_back(i); });
+    }
+
+    RenderTaskQueue::Task task;
+    RenderTaskQueue::TaskInfo info;
+    while (queue.TryPop(RenderLane::Background, task, info)) {
+        EXPECT_EQ(info.lane, RenderLane::Frame);
+        task();
+    }
+
+    EXPECT_EQ(order, (std::vector<int>{0, 1, 2}));
+    EXPECT_FALSE(queue.TryPop(RenderLane::Background, task, info));
+    EXPECT_EQ(queue.GetWakeupsCount(), 0u);
+}
+
+TEST(RenderTaskQueueTest, EarlierLanesRunFirst)
+{
+    RenderTaskQueue queue(4);
+
+    std::vector<int> order;
+    queue.Push(RenderLane::Background, [&order] { order.push_back(2); });
+    queue.Push(RenderLane::Critical, [&order] { order.push_back(1); });
+    queue.Push(RenderLane::Frame, [&order] { order.push_back(0); });
+
+    RenderTaskQueue::Task task;
+    RenderTaskQueue::TaskInfo info;
+
+    // Background tasks stay queued while the consumer takes the lanes before it only
+    while (queue.TryPop(RenderLane::Critical, task, info)) {
+        task();
+    }
+    EXPECT_EQ(order, (std::vector<int>{0, 1}));
+
+    ASSERT_TRUE(queue.TryPop(RenderLane::Background, task, info));
+    EXPECT_EQ(info.lane, RenderLane::Background);
+    task();
+
+    EXPECT_EQ(order, (std::vector<int>{0, 1, 2}));
+}
+
+TEST(RenderTaskQueueTest, BlockedProducerDrainsEveryLane)
+{
+    constexpr int Tasks = 64;
+
+    RenderTaskQueue queue(4);
+
+    std::atomic<bool> done{false};
+    int background = 0;
+
+    // The consumer never asks for the background lane, only a blocked producer makes it run these tasks
+    std::thread consumer([&] {
+        RenderTaskQueue::Task task;
+        RenderTaskQueue::TaskInfo info;
+        while (!done) {
+            if (!queue.TryPop(RenderLane::Critical, task, info)) {
+                queue.Wait(RenderLane::Critical);
+                continue;
+            }
+            task();
+        }
+    });
+
+    for (int i = 0; i < Tasks; ++i) {
+        queue.Push(RenderLane::Background, [&background] { ++background; });
+    }
+    queue.Push(RenderLane::Frame, [&done] { done = true; });
+    consumer.join();
+
+    EXPECT_GE(background, Tasks - 4);
+}
+
+TEST(RenderTaskQueueTest, ProducerAndConsumerThreads)
+{
+    constexpr int Tasks = 100'000;
+
+    // A small ring makes the producer wait for free slots and the consumer sleep on an empty ring
+    RenderTaskQueue queue(8);
+
+    std::atomic<bool> done{false};
+    int next     = 0;
+    bool ordered = true;
+
+    std::thread consumer([&] {
+        RenderTaskQueue::Task task;
+        RenderTaskQueue::TaskInfo info;
+        while (!done) {
+            if (!queue.TryPop(RenderLane::Background, task, info)) {
+                queue.Wait(RenderLane::Background);
+                continue;
+            }
+            task();
+        }
+    });
+
+    for (int i = 0; i < Tasks; ++i) {
+        queue.Push(RenderLane::Frame, [&next, &ordered, i] {
+            ordered = ordered && next == i;
+            ++next;
+        });
+
+        if (i % 1000 == 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+    queue.Push(RenderLane::Frame, [&done] { done = true; });
+    consumer.join();
+
+    EXPECT_EQ(next, Tasks);
+    EXPECT_TRUE(ordered);
+    EXPECT_LT(queue.GetWakeupsCount(), static_cast<std::uint64_t>(Tasks));
+}
@@ -0,0 +1,116 @@
+#include <engine/events/event_system.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+struct PostedEvent
+{
+    int producer = 0;
+    int value    = 0;
+};
+
+} // namespace
+
+TEST(EventChannelTest, PostDeliversOnFlush)
+{
+    game_engine::EventSystem es;
+
+    std::vector<int> values;
+    auto sub = es.Subscribe<PostedEvent>([&](const PostedEvent& event) { values.push_back(event.value); });
+
+    es.Post(PostedEvent{0, 1});
+    es.Post(PostedEvent{0, 2});
+    EXPECT_TRUE(values.empty());
+
+    es.Flush();
+    EXPECT_THAT(values, ::testing::ElementsAre(1, 2));
+
+    const auto stats = es.GetChannelStats();
+    EXPECT_EQ(stats.posted, 2u);
+    EXPECT_EQ(stats.delivered, 2u);
+    EXPECT_EQ(stats.queued, 0u);
+}
+
+TEST(EventChannelTest, MultipleProducersKeepPerProducerOrder)
+{
+    constexpr int Producers = 4;
+    constexpr int Events    = 10000;
+
+    game_engine::EventSystem es({.capacity = 64, .overflow_policy = game_engine::OverflowPolicy::Block});
+
+    std::vector<int> last_values(Producers, -1);
+    int received = 0;
+    bool ordered = true;
+
+    auto sub = es.Subscribe<PostedEvent>([&](const PostedEvent& event) {
+        ordered = ordered && event.value == last_values[event.producer] + 1;
+        last_values[event.producer] = event.value;
+        ++received;
+    });
+
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < Producers; ++producer) {
+        producers.emplace_back([&es, producer] {
+            for (int i = 0; i < Events; ++i) {
+                es.Post(PostedEvent{producer, i});
+            }
+        });
+    }
+
+    while (received < Producers * Events) {
+        es.Flush();
+    }
+
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(es.GetChannelStats().dropped, 0u);
+}
+
+TEST(EventChannelTest, DropOldestKeepsNewestEvents)
+{
+    game_engine::EventSystem es({.capacity = 4, .overflow_policy = game_engine::OverflowPolicy::DropOldest});
+
+    std::vector<int> values;
+    auto sub = es.Subscribe<PostedEvent>([&](const PostedEvent& event) { values.push_back(event.value); });
+
+    for (int i = 0; i < 10; ++i) {
+        es.Post(PostedEvent{0, i});
+    }
+    es.Flush();
+
+    EXPECT_THAT(values, ::testing::ElementsAre(6, 7, 8, 9));
+
+    const auto stats = es.GetChannelStats();
+    EXPECT_EQ(stats.posted, 10u);
+    EXPECT_EQ(stats.dropped, 6u);
+    EXPECT_EQ(stats.queued, 0u);
+}
+
+TEST(EventChannelTest, GrowKeepsAllEventsInOrder)
+{
+    game_engine::EventSystem es({.capacity = 4, .overflow_policy = game_engine::OverflowPolicy::Grow});
+
+    std::vector<int> values;
+    auto sub = es.Subscribe<PostedEvent>([&](const PostedEvent& event) { values.push_back(event.value); });
+
+    for (int i = 0; i < 10; ++i) {
+        es.Post(PostedEvent{0, i});
+    }
+    EXPECT_EQ(es.GetChannelStats().queued, 10u);
+
+    es.Flush();
+    EXPECT_THAT(values, ::testing::ElementsAre(0, 1, 2, 3, 4, 5, 6, 7, 8, 9));
+
+    const auto stats = es.GetChannelStats();
+    EXPECT_EQ(stats.overflowed, 6u);
+    EXPECT_EQ(stats.dropped, 0u);
+}
@@ -1,4 +1,5 @@
 #include <engine/events/event_system.hpp>
+#include <engine/events/window_events.hpp>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -120,12 +121,72 @@ TEST_F(EventSystemFixture, HandlerPriorityOrder)
     EXPECT_EQ(execution_order[2], 0);
 }
 
+TEST_F(EventSystemFixture, KeyedSubscriptionReceivesOnlyItsKey)
+{
+    using namespace game_engine;
+
+    int escape_presses = 0;
+    int any_key        = 0;
+
+    auto s1 = m_es.SubscribeKey(KeyCode::Escape, KeyAction::Press, [&](const auto&) { escape_presses++; });
+    auto s2 = m_es.Subscribe<KeyboardInputEvent>([&](const auto&) { any_key++; });
+
+    m_es.ProcessEvent(KeyboardInputEvent{KeyCode::Escape, KeyAction::Press});
+    m_es.ProcessEvent(KeyboardInputEvent{KeyCode::Escape, KeyAction::Release});
+    m_es.ProcessEvent(KeyboardInputEvent{KeyCode::Enter, KeyAction::Press});
+
+    EXPECT_EQ(escape_presses, 1);
+    EXPECT_EQ(any_key, 3);
+
+    s1.Unsubscribe();
+    m_es.ProcessEvent(KeyboardInputEvent{KeyCode::Escape, KeyAction::Press});
+
+    EXPECT_EQ(escape_presses, 1);
+    EXPECT_EQ(any_key, 4);
+}
+
+TEST_F(EventSystemFixture, KeyedAndUnkeyedHandlersKeepPriorityOrder)
+{
+    using namespace game_engine;
+
+    std::vector<int> execution_order;
+
+    auto s1 = m_es.Subscribe<KeyboardInputEvent>([&](const auto&) { execution_order.push_back(0); }, HandlerPriority::Whenever);
+    auto s2 = m_es.SubscribeKey(KeyCode::A, KeyAction::Press, [&](const auto&) { execution_order.push_back(1); }, HandlerPriority::Whenever);
+    auto s3 = m_es.SubscribeKey(KeyCode::A, KeyAction::Press, [&](const auto&) { execution_order.push_back(2); }, HandlerPriority::RedPanic);
+    auto s4 = m_es.Subscribe<KeyboardInputEvent>([&](const auto&) { execution_order.push_back(3); }, HandlerPriority::UrgentButCanVibe);
+
+    m_es.ProcessEvent(KeyboardInputEvent{KeyCode::A, KeyAction::Press});
+
+    EXPECT_THAT(execution_order, ::testing::ElementsAre(2, 3, 0, 1));
+}
+
+TEST_F(EventSystemFixture, KeyedSubscriptionRejectsKeyOutsideTable)
+{
+    using namespace game_engine;
+
+    EXPECT_THROW((void)m_es.SubscribeKey(static_cast<KeyCode>(100000), KeyAction::Press, [](const auto&) {}), std::out_of_range);
+}
+
+TEST_F(EventSystemFixture, PredicateSubscription)
+{
+    std::vector<int> values;
+
+    auto sub = m_es.SubscribeIf<int>([](int value) { return value % 2 == 0; }, [&](int value) { values.push_back(value); });
+
+    for (int i = 0; i < 5; ++i) {
+        m_es.ProcessEvent(i);
+    }
+
+    EXPECT_THAT(values, ::testing::ElementsAre(0, 2, 4));
+}
+
 TEST_F(EventSystemFixture, ManualUnsubscription)
 {
     int counter = 0;
 
     auto sub = m_es.Subscribe<int>([&](const auto&) { counter++; });
-    sub->Unsubscribe();
+    sub.Unsubscribe();
 
     m_es.ProcessEvent(0);
 
@@ -135,11 +196,11 @@ TEST_F(EventSystemFixture, ManualUnsubscription)
 TEST_F(EventSystemFixture, SelfUnsubscriptionInHandler)
 {
     int counter = 0;
-    game_engine::EventSystem::SubscriptionPtr self_sub;
+    game_engine::EventSystem::Subscription self_sub;
 
     self_sub = m_es.Subscribe<int>([&](const auto&) {
         counter++;
-        self_sub->Unsubscribe();
+        self_sub.Unsubscribe();
     });
 
     m_es.ProcessEvent(0); // Must be called once
@@ -148,6 +209,225 @@ TEST_F(EventSystemFixture, SelfUnsubscriptionInHandler)
     EXPECT_EQ(counter, 1);
 }
 
+TEST_F(EventSystemFixture, UnsubscribeOtherInHandler)
+{
+    using game_engine::HandlerPriority;
+
+    int first_counter  = 0;
+    int second_counter = 0;
+    game_engine::EventSystem::Subscription second_sub;
+
+    auto first_sub = m_es.Subscribe<int>([&](const auto&) {
+        first_counter++;
+        second_sub.Unsubscribe();
+    }, HandlerPriority::RedPanic);
+
+    second_sub = m_es.Subscribe<int>([&](const auto&) { second_counter++; });
+
+    m_es.ProcessEvent(0); // Second handler is removed before its turn
+    m_es.ProcessEvent(0);
+
+    EXPECT_EQ(first_counter, 2);
+    EXPECT_EQ(second_counter, 0);
+}
+
+TEST_F(EventSystemFixture, SubscribeInHandler)
+{
+    int counter = 0;
+    std::vector<game_engine::EventSystem::Subscription> subs;
+
+    subs.push_back(m_es.Subscribe<int>([&](const auto&) {
+        counter++;
+        subs.push_back(m_es.Subscribe<int>([&](const auto&) { counter++; }));
+    }));
+
+    m_es.ProcessEvent(0); // New handler takes effect from the next dispatch
+    EXPECT_EQ(counter, 1);
+
+    m_es.ProcessEvent(0);
+    EXPECT_EQ(counter, 3);
+
+    subs.clear();
+}
+
+TEST_F(EventSystemFixture, EnqueueDeliversOnFlush)
+{
+    std::vector<int> handled;
+
+    auto sub = m_es.Subscribe<int>([&](const int& event) { handled.push_back(event); });
+
+    m_es.Enqueue(1);
+    m_es.Enqueue(2);
+    m_es.Enqueue(3);
+
+    EXPECT_TRUE(handled.empty());
+
+    m_es.Flush();
+    EXPECT_EQ(handled, (std::vector<int>{1, 2, 3}));
+
+    m_es.Flush(); // Queue is empty now
+    EXPECT_EQ(handled.size(), 3);
+}
+
+TEST_F(EventSystemFixture, ImmediateHandlerRunsOnEnqueue)
+{
+    using game_engine::DeliveryMode;
+    using game_engine::HandlerPriority;
+
+    int immediate_counter = 0;
+    int deferred_counter  = 0;
+
+    auto s1 = m_es.Subscribe<int>([&](const auto&) { immediate_counter++; }, HandlerPriority::Whenever, DeliveryMode::Immediate);
+    auto s2 = m_es.Subscribe<int>([&](const auto&) { deferred_counter++; }, HandlerPriority::Whenever, DeliveryMode::Deferred);
+
+    m_es.Enqueue(0);
+    EXPECT_EQ(immediate_counter, 1);
+    EXPECT_EQ(deferred_counter, 0);
+
+    m_es.Flush();
+    EXPECT_EQ(immediate_counter, 1);
+    EXPECT_EQ(deferred_counter, 1);
+
+    // Direct processing reaches both kinds of handlers
+    m_es.ProcessEvent(0);
+    EXPECT_EQ(immediate_counter, 2);
+    EXPECT_EQ(deferred_counter, 2);
+}
+
+TEST_F(EventSystemFixture, FlushBatchesByEventType)
+{
+    struct EventA
+    {};
+
+    struct EventB
+    {};
+
+    std::vector<char> order;
+
+    auto s1 = m_es.Subscribe<EventA>([&](const auto&) { order.push_back('a'); });
+    auto s2 = m_es.Subscribe<EventB>([&](const auto&) { order.push_back('b'); });
+
+    m_es.Enqueue(EventB{});
+    m_es.Enqueue(EventA{});
+    m_es.Enqueue(EventB{});
+
+    m_es.Flush();
+
+    EXPECT_EQ(order, (std::vector<char>{'b', 'b', 'a'}));
+}
+
+TEST_F(EventSystemFixture, EnqueueInHandlerDeliveredOnNextFlush)
+{
+    int counter = 0;
+
+    auto sub = m_es.Subscribe<int>([&](const int& event) {
+        counter++;
+        if (event > 0) {
+            m_es.Enqueue(event - 1);
+        }
+    });
+
+    m_es.Enqueue(2);
+
+    m_es.Flush();
+    EXPECT_EQ(counter, 1);
+
+    m_es.Flush();
+    EXPECT_EQ(counter, 2);
+
+    m_es.Flush();
+    EXPECT_EQ(counter, 3);
+}
+
+TEST_F(EventSystemFixture, KeepLastCoalescingDeliversOneEventPerFlush)
+{
+    using namespace game_engine;
+
+    m_es.SetCoalescing<WindowResizeEvent>(CoalescePolicy::KeepLast);
+
+    std::vector<int> widths;
+    int immediate_count = 0;
+
+    auto s1 = m_es.Subscribe<WindowResizeEvent>([&](const auto& event) { widths.push_back(event.width); });
+    auto s2 = m_es.Subscribe<WindowResizeEvent>([&](const auto&) { immediate_count++; }, HandlerPriority::Whenever, DeliveryMode::Immediate);
+
+    for (int i = 1; i <= 10; ++i) {
+        m_es.Enqueue(WindowResizeEvent{i * 100, 600});
+    }
+    m_es.Flush();
+
+    EXPECT_THAT(widths, ::testing::ElementsAre(1000));
+    EXPECT_EQ(immediate_count, 10);
+    EXPECT_EQ(m_es.GetCoalescedCount<WindowResizeEvent>(), 9u);
+
+    m_es.Enqueue(WindowResizeEvent{200, 100});
+    m_es.Flush();
+
+    EXPECT_THAT(widths, ::testing::ElementsAre(1000, 200));
+}
+
+TEST_F(EventSystemFixture, MergeCoalescingUsesReducer)
+{
+    using namespace game_engine;
+
+    m_es.SetCoalescing<WindowMoveEvent>(CoalescePolicy::Merge, [](WindowMoveEvent& pending, const WindowMoveEvent& next) {
+        pending.xpos += next.xpos;
+        pending.ypos += next.ypos;
+    });
+
+    std::vector<int> positions;
+    auto sub = m_es.Subscribe<WindowMoveEvent>([&](const auto& event) { positions.push_back(event.xpos + event.ypos); });
+
+    m_es.Enqueue(WindowMoveEvent{1, 10});
+    m_es.Enqueue(WindowMoveEvent{2, 20});
+    m_es.Enqueue(WindowMoveEvent{3, 30});
+    m_es.Flush();
+
+    EXPECT_THAT(positions, ::testing::ElementsAre(66));
+    EXPECT_EQ(m_es.GetCoalescedCount<WindowMoveEvent>(), 2u);
+    EXPECT_THROW(m_es.SetCoalescing<WindowMoveEvent>(CoalescePolicy::Merge), std::invalid_argument);
+}
+
+TEST_F(EventSystemFixture, MovedSubscriptionStaysActive)
+{
+    int counter = 0;
+
+    game_engine::EventSystem::Subscription moved;
+    {
+        auto sub = m_es.Subscribe<int>([&](const auto&) { counter++; });
+        moved    = std::move(sub);
+    }
+
+    m_es.ProcessEvent(0);
+    EXPECT_EQ(counter, 1);
+
+    moved.Unsubscribe();
+    moved.Unsubscribe(); // Second call has no effect
+
+    m_es.ProcessEvent(0);
+    EXPECT_EQ(counter, 1);
+}
+
+TEST_F(EventSystemFixture, SubscriptionChurnReusesSlots)
+{
+    constexpr int Iterations = 10000;
+
+    int persistent_counter = 0;
+    int transient_counter  = 0;
+
+    auto persistent = m_es.Subscribe<int>([&](const auto&) { persistent_counter++; });
+
+    for (int i = 0; i < Iterations; ++i) {
+        auto transient = m_es.Subscribe<int>([&](const auto&) { transient_counter++; });
+        m_es.ProcessEvent(0);
+    }
+
+    m_es.ProcessEvent(0);
+
+    EXPECT_EQ(persistent_counter, Iterations + 1);
+    EXPECT_EQ(transient_counter, Iterations);
+}
+
 TEST_F(EventSystemFixture, MultithreadedProcessing)
 {
     constexpr int ThreadsCount    = 4;
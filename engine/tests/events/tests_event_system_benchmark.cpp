@@ -0,0 +1,131 @@
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+#include <engine/events/event_system.hpp>
+#include <engine/events/window_events.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace
+{
+
+constexpr int Iterations = 1'000'000;
+
+struct BenchmarkEvent
+{
+    int value = 0;
+};
+
+/// @brief Reproduces the former dispatcher lookup: type_index key, global mutex, hash map and shared_ptr copy.
+class LegacyDispatcherLookup final
+{
+public:
+
+    struct Dispatcher
+    {
+        std::function<void(const BenchmarkEvent&)> handler;
+    };
+
+    template <typename TEvent>
+    std::shared_ptr<Dispatcher> GetDispatcher()
+    {
+        const std::type_index type = typeid(TEvent);
+
+        std::lock_guard lock(m_mutex);
+        if (auto it = m_dispatchers.find(type); it != m_dispatchers.end()) {
+            return it->second;
+        }
+
+        auto dispatcher     = std::make_shared<Dispatcher>();
+        m_dispatchers[type] = dispatcher;
+        return dispatcher;
+    }
+
+private:
+
+    std::mutex m_mutex;
+    std::unordered_map<std::type_index, std::shared_ptr<Dispatcher>> m_dispatchers;
+};
+
+template <typename TFunc>
+double MeasureNanosecondsPerCall(TFunc&& func)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < Iterations; ++i) {
+        func(i);
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) / Iterations;
+}
+
+} // namespace
+
+TEST(EventSystemBenchmark, DispatcherLookup)
+{
+    int legacy_sum = 0;
+    int sum        = 0;
+
+    LegacyDispatcherLookup legacy;
+    legacy.GetDispatcher<BenchmarkEvent>()->handler = [&](const BenchmarkEvent& event) { legacy_sum += event.value; };
+
+    game_engine::EventSystem es;
+    auto sub = es.Subscribe<BenchmarkEvent>([&](const BenchmarkEvent& event) { sum += event.value; });
+
+    const double legacy_ns = MeasureNanosecondsPerCall([&](int i) { legacy.GetDispatcher<BenchmarkEvent>()->handler(BenchmarkEvent{i & 1}); });
+    const double ns        = MeasureNanosecondsPerCall([&](int i) { es.ProcessEvent(BenchmarkEvent{i & 1}); });
+
+    std::cout << "[ BENCHMARK ] legacy lookup + dispatch: " << legacy_ns << " ns/event\n"
+              << "[ BENCHMARK ] indexed lookup + dispatch: " << ns << " ns/event\n";
+
+    RecordProperty("legacy_ns_per_event", std::to_string(legacy_ns));
+    RecordProperty("ns_per_event", std::to_string(ns));
+
+    EXPECT_EQ(sum, legacy_sum);
+    EXPECT_EQ(sum, Iterations / 2);
+}
+
+TEST(EventSystemBenchmark, KeyedDispatch)
+{
+    using namespace game_engine;
+
+    constexpr int Bindings = 300;
+
+    int filtered_hits = 0;
+    int keyed_hits    = 0;
+
+    EventSystem filtered_es;
+    EventSystem keyed_es;
+
+    std::vector<EventSystem::Subscription> subscriptions;
+    for (int i = 0; i < Bindings; ++i) {
+        const auto key = static_cast<KeyCode>(static_cast<int>(KeyCode::Escape) + i % 64);
+        subscriptions.push_back(filtered_es.Subscribe<KeyboardInputEvent>([&filtered_hits, key](const KeyboardInputEvent& event) {
+            if (event.key == key && event.action == KeyAction::Press) {
+                filtered_hits++;
+            }
+        }));
+        subscriptions.push_back(keyed_es.SubscribeKey(key, KeyAction::Press, [&keyed_hits](const auto&) { keyed_hits++; }));
+    }
+
+    const auto make_event = [](int i) {
+        return KeyboardInputEvent{static_cast<KeyCode>(static_cast<int>(KeyCode::Escape) + i % 64), KeyAction::Press};
+    };
+
+    const double filtered_ns = MeasureNanosecondsPerCall([&](int i) { filtered_es.ProcessEvent(make_event(i)); });
+    const double keyed_ns    = MeasureNanosecondsPerCall([&](int i) { keyed_es.ProcessEvent(make_event(i)); });
+
+    std::cout << "[ BENCHMARK ] " << Bindings << " bindings, filter in handler: " << filtered_ns << " ns/event\n"
+              << "[ BENCHMARK ] " << Bindings << " bindings, keyed subscription: " << keyed_ns << " ns/event\n";
+
+    RecordProperty("filtered_ns_per_event", std::to_string(filtered_ns));
+    RecordProperty("keyed_ns_per_event", std::to_string(keyed_ns));
+
+    EXPECT_EQ(keyed_hits, filtered_hits);
+}
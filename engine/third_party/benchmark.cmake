@@ -0,0 +1,19 @@
+include(FetchContent)
+
+FetchContent_Declare(
+    googlebenchmark
+    GIT_REPOSITORY https://github.com/google/benchmark.git
+    GIT_TAG        v1.9.1
+)
+
+set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+set(BENCHMARK_ENABLE_INSTALL OFF CACHE BOOL "" FORCE)
+set(BENCHMARK_ENABLE_GTEST_TESTS OFF CACHE BOOL "" FORCE)
+
+FetchContent_MakeAvailable(googlebenchmark)
+
+set_target_properties(benchmark benchmark_main PROPERTIES FOLDER "engine/third_party/benchmark")
+
+# Define lids to link
+add_library(third_party::benchmark INTERFACE IMPORTED)
+target_link_libraries(third_party::benchmark INTERFACE benchmark::benchmark)
@@ -1,5 +1,6 @@
 #include "game.hpp"
 
+#include <array>
 #include <iostream>
 
 #include <engine/events/window_events.hpp>
@@ -108,13 +109,13 @@ void Game::OnDraw()
     const auto view       = glm::translate(Matrix4(1.0f), Vector3(0.0f, 0.0f, -3.0f));
     const auto projection = glm::perspective(glm::radians(45.0f), 800.0f / 600.0f, 0.1f, 100.0f);
 
-    m_engine->GetRenderer()->Render(m_mesh,
-        m_shader,
-        {
-            Property{     "model",      model},
-            Property{      "view",       view},
-            Property{"projection", projection},
-    });
+    const std::array<PropertyBinding, 3> properties = {
+        PropertyBinding{     m_model_id,      model},
+        PropertyBinding{      m_view_id,       view},
+        PropertyBinding{m_projection_id, projection},
+    };
+
+    m_engine->GetRenderer()->Render(m_mesh, m_shader, properties, DrawOrder{});
 }
 
 bool Game::OnShouldClose()
@@ -142,10 +143,8 @@ void Game::SubscribeForEvents()
 {
     using namespace game_engine;
 
-    m_subscriptions.push_back(m_engine->GetEventSystem()->Subscribe<KeyboardInputEvent>([this](const auto& event) {
-        if (event.key == KeyCode::Escape && event.action == KeyAction::Press) {
-            m_engine->SetShouldStopFlag();
-        }
+    m_subscriptions.push_back(m_engine->GetEventSystem()->SubscribeKey(KeyCode::Escape, KeyAction::Press, [this](const auto&) {
+        m_engine->SetShouldStopFlag();
     }));
 }
 
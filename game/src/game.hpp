@@ -2,6 +2,7 @@
 
 #include <engine/events/event_system.hpp>
 #include <engine/game.hpp>
+#include <engine/graphics/property.hpp>
 
 class Game final : public game_engine::IGame
 {
@@ -26,11 +27,15 @@ private:
 
     std::shared_ptr<game_engine::IEngine> m_engine;
 
-    std::vector<game_engine::EventSystem::SubscriptionPtr> m_subscriptions;
+    std::vector<game_engine::EventSystem::Subscription> m_subscriptions;
 
     std::shared_ptr<game_engine::IShader> m_shader;
     std::shared_ptr<game_engine::IMesh> m_mesh;
 
+    const game_engine::PropertyId m_model_id{"model"};
+    const game_engine::PropertyId m_view_id{"view"};
+    const game_engine::PropertyId m_projection_id{"projection"};
+
     std::size_t m_updates_count = 0;
     std::size_t m_frames_count  = 0;
 };